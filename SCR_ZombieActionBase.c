@@ -12,6 +12,12 @@ class SCR_ZombieActionBase : AIActionBase
     [Attribute("1.5", UIWidgets.Auto, "Attack cooldown in seconds")]
     protected float m_fAttackCooldown;
     
+    [Attribute("0.3", UIWidgets.Slider, "Chance that a hit makes the target bleed", "0 1 0.05")]
+    protected float m_fBleedChance;
+    
+    [Attribute("30.0", UIWidgets.Auto, "Bleeding duration in seconds, bandages stop it earlier")]
+    protected float m_fBleedDuration;
+    
     [Attribute("30.0", UIWidgets.Auto, "Detection range in meters")]
     protected float m_fDetectionRange;
     
@@ -25,6 +31,7 @@ class SCR_ZombieActionBase : AIActionBase
     protected bool m_bHasLostTarget;
     protected vector m_vLastKnownTargetPosition;
     protected float m_fLostTargetTime;
+    protected int m_iUpdateTimer;
     
     // Initial target entity (optional)
     IEntity m_InitialTarget;
@@ -49,21 +56,34 @@ class SCR_ZombieActionBase : AIActionBase
         }
         
         // Start zombie behavior
-        GetGame().GetCallqueue().CallLater(ZombieUpdate, 500, true, agent);
+        m_iUpdateTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(ZombieUpdate, 500, true, agent);
     }
     
     override void OnDeactivate(AIAgent agent)
     {
         super.OnDeactivate(agent);
-        GetGame().GetCallqueue().Remove(ZombieUpdate);
+        SCR_ZombieTimerWheel.CancelTimer(m_iUpdateTimer);
     }
     
-    protected void ZombieUpdate(AIAgent agent)
+    protected void ZombieUpdate(Managed context)
     {
+        AIAgent agent = AIAgent.Cast(context);
+        if (!agent)
+            return;
+            
         IEntity entity = agent.GetControlledEntity();
         if (!entity)
             return;
             
+        // Mid and far zombies are moved by the movement LOD instead
+        SCR_ZombieMovementLOD movementLOD = SCR_ZombieMovementLOD.GetInstance();
+        if (!movementLOD.IsFullSimulation(entity))
+            return;
+            
+        // Horde followers are steered after their leader, only the leader thinks and pathfinds
+        if (SCR_ZombieHordeManager.GetInstance().IsFollower(entity))
+            return;
+            
         // Check if our current target is still valid
         if (m_TargetEntity && !m_bHasLostTarget)
         {
@@ -157,12 +177,14 @@ class SCR_ZombieActionBase : AIActionBase
             }
             else if (m_TargetEntity)
             {
-                // Move toward target
-                NavigateToEntity(agent, m_TargetEntity);
+                // Move to our slot around the target, the queue ring while all attack slots are taken
+                vector slotPosition;
+                SCR_EZombieAttackRole role = SCR_ZombieAttackSlots.GetInstance().Request(entity, m_TargetEntity, slotPosition);
+                NavigateToPosition(agent, slotPosition);
                 
-                // Check if close enough to attack
+                // Check if close enough to attack, only attack slot holders strike
                 float distance = vector.Distance(entity.GetOrigin(), m_TargetEntity.GetOrigin());
-                if (distance < 2.0) // Attack range
+                if (role == SCR_EZombieAttackRole.ATTACK && distance < 2.0) // Attack range
                 {
                     float currentTime = GetGame().GetWorld().GetWorldTime();
                     if (currentTime - m_fLastAttackTime > m_fAttackCooldown)
@@ -257,19 +279,20 @@ class SCR_ZombieActionBase : AIActionBase
         if (dmgMgr)
         {
             DamageParams params = new DamageParams();
-            params.Damage = m_fAttackDamage;
+            params.Damage = m_fAttackDamage * SCR_ZombieStatModifierManager.GetInstance().GetValue(target, SCR_EZombieStat.DAMAGE_TAKEN);
             params.DamageType = EDamageType.MELEE;
             params.Instigator = entity;
             
             dmgMgr.InflictDamage(params);
             
-            // Apply infection status if implemented
-            SCR_CharacterControllerComponent targetCtrl = SCR_CharacterControllerComponent.Cast(target.FindComponent(SCR_CharacterControllerComponent));
-            if (targetCtrl)
-            {
-                // infection system,
-                // ApplyInfectionStatus(targetCtrl);
-            }
+            // Apply infection status, players not tracked by the infection system are ignored
+            SCR_ZombieInfectionManager infectionManager = SCR_ZombieInfectionManager.GetInstance();
+            if (infectionManager)
+                infectionManager.ApplyAttackInfection(target);
+                
+            // Scratches bleed, damage over time is applied by the status effect manager
+            if (Math.RandomFloat01() < m_fBleedChance)
+                SCR_ZombieStatusEffectManager.GetInstance().AddEffect(target, SCR_EZombieStatusEffect.BLEEDING, m_fBleedDuration);
         }
         
         // Play attack sound
@@ -323,6 +346,7 @@ class SCR_ZombieActionBase : AIActionBase
         if (navComp)
         {
             navComp.SetTarget(position);
+            SCR_ZombieHordeManager.GetInstance().CountPathRequest();
         }
     }
     
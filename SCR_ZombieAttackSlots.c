@@ -0,0 +1,312 @@
+enum SCR_EZombieAttackRole
+{
+    ATTACK,
+    WAIT,
+    OVERFLOW
+}
+
+// Slot rings around one chased player, null entries are free slots
+class SCR_ZombieAttackRing
+{
+    IEntity m_Target;
+    ref array<IEntity> m_aAttackers = new array<IEntity>();
+    ref array<IEntity> m_aWaiters = new array<IEntity>();
+    
+    // Zombies chasing this player in the current assignment pass, nearest first
+    ref array<IEntity> m_aCandidates = new array<IEntity>();
+    ref array<float> m_aCandidateDistances = new array<float>();
+}
+
+// Limits how many zombies crowd one player. Each chased player has a ring of attack slots close
+// around them and a queue ring further out; chasing zombies request a slot every AI update and
+// ZombieManager's scheduler hands out the slots, nearest zombies first, holders kept while they
+// still ask. Only attack slot holders strike, queued zombies wait on the outer ring.
+class SCR_ZombieAttackSlots
+{
+    static const int ATTACK_SLOTS = 6;
+    static const float ATTACK_RADIUS = 1.5;
+    static const int WAIT_SLOTS = 10;
+    static const float WAIT_RADIUS = 6;
+    
+    // Requests older than this belong to zombies that stopped chasing or died
+    static const float REQUEST_TIMEOUT_MS = 2000;
+    
+    protected static ref SCR_ZombieAttackSlots s_Instance;
+    
+    protected ref map<IEntity, ref SCR_ZombieAttackRing> m_mRings = new map<IEntity, ref SCR_ZombieAttackRing>();
+    protected ref map<IEntity, IEntity> m_mRequestTargets = new map<IEntity, IEntity>();
+    protected ref map<IEntity, float> m_mRequestTimes = new map<IEntity, float>();
+    
+    // Per pass scratch
+    protected ref array<IEntity> m_aStaleZombies = new array<IEntity>();
+    protected ref array<IEntity> m_aStaleTargets = new array<IEntity>();
+    
+    protected int m_iAttackerCount;
+    protected int m_iWaiterCount;
+    protected int m_iOverflowCount;
+    
+    static SCR_ZombieAttackSlots GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieAttackSlots();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieAttackSlots FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        s_Instance = null;
+    }
+    
+    // Called by a chasing zombie, returns its role and where it should move to. Zombies without an
+    // assignment yet queue on the outer ring on their own bearing.
+    SCR_EZombieAttackRole Request(IEntity zombie, IEntity target, out vector position)
+    {
+        m_mRequestTargets.Set(zombie, target);
+        m_mRequestTimes.Set(zombie, GetGame().GetWorld().GetWorldTime());
+        
+        vector targetPos = target.GetOrigin();
+        SCR_ZombieAttackRing ring = m_mRings.Get(target);
+        if (ring)
+        {
+            int slot = ring.m_aAttackers.Find(zombie);
+            if (slot != -1)
+            {
+                position = GetSlotPosition(targetPos, slot, ATTACK_SLOTS, ATTACK_RADIUS);
+                return SCR_EZombieAttackRole.ATTACK;
+            }
+            
+            slot = ring.m_aWaiters.Find(zombie);
+            if (slot != -1)
+            {
+                position = GetSlotPosition(targetPos, slot, WAIT_SLOTS, WAIT_RADIUS);
+                return SCR_EZombieAttackRole.WAIT;
+            }
+        }
+        
+        vector fromTarget = zombie.GetOrigin() - targetPos;
+        fromTarget[1] = 0;
+        fromTarget.Normalize();
+        position = targetPos + fromTarget * WAIT_RADIUS;
+        return SCR_EZombieAttackRole.OVERFLOW;
+    }
+    
+    void Forget(IEntity zombie)
+    {
+        m_mRequestTargets.Remove(zombie);
+        m_mRequestTimes.Remove(zombie);
+        
+        foreach (IEntity target, SCR_ZombieAttackRing ring : m_mRings)
+        {
+            ReleaseFrom(ring.m_aAttackers, zombie);
+            ReleaseFrom(ring.m_aWaiters, zombie);
+        }
+    }
+    
+    void Clear()
+    {
+        m_mRings.Clear();
+        m_mRequestTargets.Clear();
+        m_mRequestTimes.Clear();
+    }
+    
+    int GetAttackerCount()
+    {
+        return m_iAttackerCount;
+    }
+    
+    int GetWaiterCount()
+    {
+        return m_iWaiterCount;
+    }
+    
+    int GetOverflowCount()
+    {
+        return m_iOverflowCount;
+    }
+    
+    // One scheduler pass over every request
+    void Assign()
+    {
+        float now = GetGame().GetWorld().GetWorldTime();
+        
+        foreach (IEntity ringTarget, SCR_ZombieAttackRing clearedRing : m_mRings)
+        {
+            clearedRing.m_aCandidates.Clear();
+            clearedRing.m_aCandidateDistances.Clear();
+        }
+        
+        // Drop stale requests, bucket the rest by target
+        m_aStaleZombies.Clear();
+        foreach (IEntity zombie, IEntity target : m_mRequestTargets)
+        {
+            if (!zombie || !target || now - m_mRequestTimes.Get(zombie) > REQUEST_TIMEOUT_MS)
+            {
+                m_aStaleZombies.Insert(zombie);
+                continue;
+            }
+            
+            SCR_ZombieAttackRing ring = m_mRings.Get(target);
+            if (!ring)
+                ring = AddRing(target);
+                
+            InsertCandidate(ring, zombie, vector.DistanceSq(zombie.GetOrigin(), target.GetOrigin()));
+        }
+        
+        foreach (IEntity staleZombie : m_aStaleZombies)
+        {
+            m_mRequestTargets.Remove(staleZombie);
+            m_mRequestTimes.Remove(staleZombie);
+        }
+        
+        m_iAttackerCount = 0;
+        m_iWaiterCount = 0;
+        m_iOverflowCount = 0;
+        
+        m_aStaleTargets.Clear();
+        foreach (IEntity assignedTarget, SCR_ZombieAttackRing assignedRing : m_mRings)
+        {
+            if (!assignedTarget || assignedRing.m_aCandidates.IsEmpty())
+            {
+                m_aStaleTargets.Insert(assignedTarget);
+                continue;
+            }
+            
+            AssignRing(assignedRing);
+        }
+        
+        foreach (IEntity staleTarget : m_aStaleTargets)
+        {
+            m_mRings.Remove(staleTarget);
+        }
+    }
+    
+    protected SCR_ZombieAttackRing AddRing(IEntity target)
+    {
+        SCR_ZombieAttackRing ring = new SCR_ZombieAttackRing();
+        ring.m_Target = target;
+        
+        for (int i = 0; i < ATTACK_SLOTS; i++)
+        {
+            ring.m_aAttackers.Insert(null);
+        }
+        
+        for (int j = 0; j < WAIT_SLOTS; j++)
+        {
+            ring.m_aWaiters.Insert(null);
+        }
+        
+        m_mRings.Insert(target, ring);
+        return ring;
+    }
+    
+    protected void AssignRing(SCR_ZombieAttackRing ring)
+    {
+        array<IEntity> candidates = ring.m_aCandidates;
+        vector targetPos = ring.m_Target.GetOrigin();
+        
+        // Attackers keep their slot while they still chase this player
+        for (int attackSlot = 0; attackSlot < ATTACK_SLOTS; attackSlot++)
+        {
+            IEntity holder = ring.m_aAttackers[attackSlot];
+            if (holder && candidates.Find(holder) == -1)
+                ring.m_aAttackers[attackSlot] = null;
+        }
+        
+        // Free attack slots go to the nearest candidates, the queue ring is rebuilt from the rest
+        for (int waitSlot = 0; waitSlot < WAIT_SLOTS; waitSlot++)
+        {
+            ring.m_aWaiters[waitSlot] = null;
+        }
+        
+        foreach (IEntity candidate : candidates)
+        {
+            if (ring.m_aAttackers.Find(candidate) != -1)
+            {
+                m_iAttackerCount++;
+                continue;
+            }
+            
+            vector bearing = candidate.GetOrigin() - targetPos;
+            int slot = FindFreeSlot(ring.m_aAttackers, bearing);
+            if (slot != -1)
+            {
+                ring.m_aAttackers[slot] = candidate;
+                m_iAttackerCount++;
+                continue;
+            }
+            
+            slot = FindFreeSlot(ring.m_aWaiters, bearing);
+            if (slot != -1)
+            {
+                ring.m_aWaiters[slot] = candidate;
+                m_iWaiterCount++;
+                continue;
+            }
+            
+            m_iOverflowCount++;
+        }
+    }
+    
+    // Free slot closest to the zombie's bearing from the player, so zombies do not cross the ring
+    protected int FindFreeSlot(array<IEntity> slots, vector bearing)
+    {
+        float angle = Math.Atan2(bearing[0], bearing[2]);
+        if (angle < 0)
+            angle += Math.PI2;
+            
+        float slotAngle = Math.PI2 / slots.Count();
+        
+        int best = -1;
+        float bestDelta = float.MAX;
+        for (int slot = 0; slot < slots.Count(); slot++)
+        {
+            if (slots[slot])
+                continue;
+                
+            float delta = Math.AbsFloat(angle - slot * slotAngle);
+            delta = Math.Min(delta, Math.PI2 - delta);
+            if (delta < bestDelta)
+            {
+                bestDelta = delta;
+                best = slot;
+            }
+        }
+        
+        return best;
+    }
+    
+    protected vector GetSlotPosition(vector targetPos, int slot, int slotCount, float radius)
+    {
+        float angle = slot * Math.PI2 / slotCount;
+        vector position = targetPos + Vector(Math.Sin(angle) * radius, 0, Math.Cos(angle) * radius);
+        position[1] = GetGame().GetWorld().GetSurfaceY(position[0], position[2]);
+        return position;
+    }
+    
+    // Sorted insert, nearest first; only a few zombies chase one player
+    protected void InsertCandidate(SCR_ZombieAttackRing ring, IEntity zombie, float distanceSq)
+    {
+        int index = ring.m_aCandidateDistances.Count();
+        while (index > 0 && ring.m_aCandidateDistances[index - 1] > distanceSq)
+        {
+            index--;
+        }
+        
+        ring.m_aCandidates.InsertAt(zombie, index);
+        ring.m_aCandidateDistances.InsertAt(distanceSq, index);
+    }
+    
+    protected void ReleaseFrom(array<IEntity> slots, IEntity zombie)
+    {
+        int slot = slots.Find(zombie);
+        if (slot != -1)
+            slots[slot] = null;
+    }
+}
@@ -0,0 +1,289 @@
+// Decides which zombies vocalize. Every registered zombie has one entry in a min-heap on its next
+// vocalization time, driven by a single wheel timer. Due zombies out of earshot of every player are
+// pushed back without playing, and a zombie only plays while each player in earshot hears fewer
+// than the voice cap. Unregistered zombies leave stale heap entries that are dropped by serial.
+class SCR_ZombieAudioDirector
+{
+    static const float TICK_INTERVAL_MS = 250;
+    static const float HEARING_RADIUS = 60;
+    static const int MAX_VOICES_PER_LISTENER = 4;
+    static const float VOICE_DURATION_MS = 3000;
+    static const int MAX_SOUNDS_PER_TICK = 8;
+    
+    protected static ref SCR_ZombieAudioDirector s_Instance;
+    
+    protected ref map<IEntity, int> m_mSerials = new map<IEntity, int>();
+    
+    // Min-heap on next vocalization time
+    protected ref array<float> m_aHeapTimes = new array<float>();
+    protected ref array<AudioComponent> m_aHeapAudio = new array<AudioComponent>();
+    protected ref array<int> m_aHeapSerials = new array<int>();
+    
+    // Voices still playing
+    protected ref array<vector> m_aVoicePositions = new array<vector>();
+    protected ref array<float> m_aVoiceEndTimes = new array<float>();
+    
+    // Per tick scratch
+    protected ref array<vector> m_aListenerPositions = new array<vector>();
+    protected ref array<int> m_aPlayerIds = new array<int>();
+    
+    protected int m_iNextSerial = 1;
+    protected int m_iTickTimer;
+    
+    protected int m_iPlayedCount;
+    protected int m_iDeferredCount;
+    protected int m_iCulledCount;
+    
+    static SCR_ZombieAudioDirector GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieAudioDirector();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieAudioDirector FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        if (!s_Instance)
+            return;
+            
+        SCR_ZombieTimerWheel.CancelTimer(s_Instance.m_iTickTimer);
+        s_Instance = null;
+    }
+    
+    void SCR_ZombieAudioDirector()
+    {
+        m_iTickTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(Tick, TICK_INTERVAL_MS, true);
+    }
+    
+    void Register(AudioComponent audio)
+    {
+        IEntity zombie = audio.GetOwner();
+        if (!zombie)
+            return;
+            
+        int serial = m_iNextSerial++;
+        m_mSerials.Set(zombie, serial);
+        HeapPush(GetGame().GetWorld().GetWorldTime() + Math.RandomFloat(5000, 15000), audio, serial);
+    }
+    
+    void Unregister(IEntity zombie)
+    {
+        m_mSerials.Remove(zombie);
+    }
+    
+    void Clear()
+    {
+        m_mSerials.Clear();
+        m_aHeapTimes.Clear();
+        m_aHeapAudio.Clear();
+        m_aHeapSerials.Clear();
+        m_aVoicePositions.Clear();
+        m_aVoiceEndTimes.Clear();
+    }
+    
+    int GetRegisteredCount()
+    {
+        return m_mSerials.Count();
+    }
+    
+    int GetActiveVoiceCount()
+    {
+        return m_aVoicePositions.Count();
+    }
+    
+    int GetPlayedCount()
+    {
+        return m_iPlayedCount;
+    }
+    
+    int GetDeferredCount()
+    {
+        return m_iDeferredCount;
+    }
+    
+    int GetCulledCount()
+    {
+        return m_iCulledCount;
+    }
+    
+    protected void Tick(Managed context = null)
+    {
+        float now = GetGame().GetWorld().GetWorldTime();
+        if (m_aHeapTimes.IsEmpty() || m_aHeapTimes[0] > now)
+            return;
+            
+        CollectListenerPositions();
+        PruneVoices(now);
+        
+        int played = 0;
+        while (!m_aHeapTimes.IsEmpty() && m_aHeapTimes[0] <= now && played < MAX_SOUNDS_PER_TICK)
+        {
+            AudioComponent audio = m_aHeapAudio[0];
+            int serial = m_aHeapSerials[0];
+            HeapPop();
+            
+            // Entries of dead, despawned or re-registered zombies are simply dropped here
+            if (!audio || !audio.GetOwner() || m_mSerials.Get(audio.GetOwner()) != serial)
+                continue;
+                
+            vector position = audio.GetOwner().GetOrigin();
+            if (!IsAudible(position))
+            {
+                m_iCulledCount++;
+                HeapPush(now + Math.RandomFloat(8000, 20000), audio, serial);
+                continue;
+            }
+            
+            // Retried shortly, the crowd around the listener may have quietened by then
+            if (!HasFreeVoice(position))
+            {
+                m_iDeferredCount++;
+                HeapPush(now + Math.RandomFloat(1000, 3000), audio, serial);
+                continue;
+            }
+            
+            audio.PlaySound(PickSoundEvent());
+            m_aVoicePositions.Insert(position);
+            m_aVoiceEndTimes.Insert(now + VOICE_DURATION_MS);
+            m_iPlayedCount++;
+            played++;
+            
+            HeapPush(now + Math.RandomFloat(8000, 20000), audio, serial);
+        }
+    }
+    
+    protected string PickSoundEvent()
+    {
+        // Idle twice as often as alert
+        if (Math.RandomInt(0, 3) == 1)
+            return "SOUND_ZOMBIE_ALERT";
+            
+        return "SOUND_ZOMBIE_IDLE";
+    }
+    
+    protected bool IsAudible(vector position)
+    {
+        float hearingSq = HEARING_RADIUS * HEARING_RADIUS;
+        foreach (vector listenerPosition : m_aListenerPositions)
+        {
+            if (vector.DistanceSq(position, listenerPosition) <= hearingSq)
+                return true;
+        }
+        
+        return false;
+    }
+    
+    // Every listener that would hear the sound has to be under the cap
+    protected bool HasFreeVoice(vector position)
+    {
+        float hearingSq = HEARING_RADIUS * HEARING_RADIUS;
+        foreach (vector listenerPosition : m_aListenerPositions)
+        {
+            if (vector.DistanceSq(position, listenerPosition) > hearingSq)
+                continue;
+                
+            int voices = 0;
+            foreach (vector voicePosition : m_aVoicePositions)
+            {
+                if (vector.DistanceSq(voicePosition, listenerPosition) <= hearingSq)
+                    voices++;
+            }
+            
+            if (voices >= MAX_VOICES_PER_LISTENER)
+                return false;
+        }
+        
+        return true;
+    }
+    
+    protected void PruneVoices(float now)
+    {
+        for (int i = m_aVoiceEndTimes.Count() - 1; i >= 0; i--)
+        {
+            if (m_aVoiceEndTimes[i] > now)
+                continue;
+                
+            int last = m_aVoiceEndTimes.Count() - 1;
+            m_aVoicePositions[i] = m_aVoicePositions[last];
+            m_aVoiceEndTimes[i] = m_aVoiceEndTimes[last];
+            m_aVoicePositions.Remove(last);
+            m_aVoiceEndTimes.Remove(last);
+        }
+    }
+    
+    protected void CollectListenerPositions()
+    {
+        m_aPlayerIds.Clear();
+        m_aListenerPositions.Clear();
+        
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        playerManager.GetPlayers(m_aPlayerIds);
+        foreach (int playerId : m_aPlayerIds)
+        {
+            IEntity playerEntity = playerManager.GetPlayerControlledEntity(playerId);
+            if (playerEntity)
+                m_aListenerPositions.Insert(playerEntity.GetOrigin());
+        }
+    }
+    
+    protected void HeapPush(float time, AudioComponent audio, int serial)
+    {
+        int index = m_aHeapTimes.Insert(time);
+        m_aHeapAudio.Insert(audio);
+        m_aHeapSerials.Insert(serial);
+        
+        while (index > 0)
+        {
+            int parent = (index - 1) / 2;
+            if (m_aHeapTimes[parent] <= m_aHeapTimes[index])
+                break;
+                
+            HeapSwap(index, parent);
+            index = parent;
+        }
+    }
+    
+    protected void HeapPop()
+    {
+        int last = m_aHeapTimes.Count() - 1;
+        HeapSwap(0, last);
+        m_aHeapTimes.Remove(last);
+        m_aHeapAudio.Remove(last);
+        m_aHeapSerials.Remove(last);
+        
+        int count = m_aHeapTimes.Count();
+        int index = 0;
+        while (true)
+        {
+            int smallest = index;
+            int left = index * 2 + 1;
+            int right = left + 1;
+            
+            if (left < count && m_aHeapTimes[left] < m_aHeapTimes[smallest])
+                smallest = left;
+                
+            if (right < count && m_aHeapTimes[right] < m_aHeapTimes[smallest])
+                smallest = right;
+                
+            if (smallest == index)
+                break;
+                
+            HeapSwap(index, smallest);
+            index = smallest;
+        }
+    }
+    
+    protected void HeapSwap(int a, int b)
+    {
+        m_aHeapTimes.SwapItems(a, b);
+        m_aHeapAudio.SwapItems(a, b);
+        m_aHeapSerials.SwapItems(a, b);
+    }
+}
@@ -0,0 +1,277 @@
+enum SCR_EZombieCleanupType
+{
+    CORPSE,
+    DROPPED_ITEM,
+    LEFTOVER
+}
+
+// Server-side garbage collector for zombie corpses, loot players took and dropped again, and
+// leftovers of consumed items. Each type has a cap and a maximum age; entities over the cap or past
+// their age are removed in order of age and distance to the nearest player, never near a player,
+// and never more than the per-frame budget.
+class SCR_ZombieCleanupManager : ScriptComponent
+{
+    static const int TYPE_COUNT = 3;
+    static const float EXPIRED_PRIORITY = 10;
+    
+    [Attribute("30", UIWidgets.Auto, "Maximum number of zombie corpses kept")]
+    protected int m_iMaxCorpses;
+    
+    [Attribute("300", UIWidgets.Auto, "Seconds after which a corpse is removed")]
+    protected float m_fCorpseMaxAge;
+    
+    [Attribute("100", UIWidgets.Auto, "Maximum number of dropped loot items kept")]
+    protected int m_iMaxDroppedItems;
+    
+    [Attribute("1800", UIWidgets.Auto, "Seconds after which a dropped loot item is removed")]
+    protected float m_fDroppedItemMaxAge;
+    
+    [Attribute("20", UIWidgets.Auto, "Maximum number of consumed item leftovers kept")]
+    protected int m_iMaxLeftovers;
+    
+    [Attribute("60", UIWidgets.Auto, "Seconds after which a consumed item leftover is removed")]
+    protected float m_fLeftoverMaxAge;
+    
+    [Attribute("50", UIWidgets.Auto, "Nothing within this distance in meters of a player is removed")]
+    protected float m_fProtectionDistance;
+    
+    [Attribute("8", UIWidgets.Auto, "Maximum number of entities deleted per frame")]
+    protected int m_iDeletionBudget;
+    
+    [Attribute("5", UIWidgets.Auto, "Interval in seconds between cleanup passes")]
+    protected float m_fCleanupInterval;
+    
+    protected static SCR_ZombieCleanupManager s_Instance;
+    
+    // Per SCR_EZombieCleanupType
+    protected ref array<ref array<IEntity>> m_aEntities = new array<ref array<IEntity>>();
+    protected ref array<ref array<float>> m_aTrackTimes = new array<ref array<float>>();
+    protected ref array<ref array<InventoryItemComponent>> m_aInventoryItems = new array<ref array<InventoryItemComponent>>();
+    protected ref array<int> m_aCaps = new array<int>();
+    protected ref array<float> m_aMaxAges = new array<float>();
+    protected ref array<int> m_aDeletedCounts = {0, 0, 0};
+    
+    // Per pass scratch, scores of the current type's entities
+    protected ref array<float> m_aScores = new array<float>();
+    protected ref array<vector> m_aPlayerPositions = new array<vector>();
+    protected ref array<int> m_aPlayerIds = new array<int>();
+    
+    protected int m_iPassTimer;
+    protected int m_iPeakFrameDeletions;
+    
+    static SCR_ZombieCleanupManager GetInstance()
+    {
+        return s_Instance;
+    }
+    
+    override void OnPostInit(IEntity owner)
+    {
+        super.OnPostInit(owner);
+        
+        s_Instance = this;
+        
+        // Indexed by SCR_EZombieCleanupType
+        m_aCaps.Insert(m_iMaxCorpses);
+        m_aCaps.Insert(m_iMaxDroppedItems);
+        m_aCaps.Insert(m_iMaxLeftovers);
+        m_aMaxAges.Insert(m_fCorpseMaxAge * 1000);
+        m_aMaxAges.Insert(m_fDroppedItemMaxAge * 1000);
+        m_aMaxAges.Insert(m_fLeftoverMaxAge * 1000);
+        
+        for (int i = 0; i < TYPE_COUNT; i++)
+        {
+            m_aEntities.Insert(new array<IEntity>());
+            m_aTrackTimes.Insert(new array<float>());
+            m_aInventoryItems.Insert(new array<InventoryItemComponent>());
+        }
+        
+        m_iPassTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(CleanupPass, m_fCleanupInterval * 1000);
+    }
+    
+    override void OnDelete(IEntity owner)
+    {
+        SCR_ZombieTimerWheel.CancelTimer(m_iPassTimer);
+        
+        if (s_Instance == this)
+            s_Instance = null;
+            
+        super.OnDelete(owner);
+    }
+    
+    void Track(IEntity entity, SCR_EZombieCleanupType type)
+    {
+        if (!entity || m_aEntities[type].Find(entity) != -1)
+            return;
+            
+        m_aEntities[type].Insert(entity);
+        m_aTrackTimes[type].Insert(GetGame().GetWorld().GetWorldTime());
+        m_aInventoryItems[type].Insert(InventoryItemComponent.Cast(entity.FindComponent(InventoryItemComponent)));
+    }
+    
+    int GetTrackedCount(SCR_EZombieCleanupType type)
+    {
+        return m_aEntities[type].Count();
+    }
+    
+    int GetDeletedCount(SCR_EZombieCleanupType type)
+    {
+        return m_aDeletedCounts[type];
+    }
+    
+    int GetPeakFrameDeletions()
+    {
+        return m_iPeakFrameDeletions;
+    }
+    
+    // Spends the frame budget across the types; while work is left the next slice runs next tick
+    protected void CleanupPass(Managed context = null)
+    {
+        CollectPlayerPositions();
+        
+        int budget = m_iDeletionBudget;
+        bool workLeft = false;
+        for (int type = 0; type < TYPE_COUNT; type++)
+        {
+            int deleted = CleanupType(type, budget);
+            budget -= deleted;
+            
+            // Out of budget, the remaining candidates are handled next tick
+            if (budget <= 0)
+            {
+                workLeft = true;
+                break;
+            }
+        }
+        
+        m_iPeakFrameDeletions = Math.Max(m_iPeakFrameDeletions, m_iDeletionBudget - budget);
+        
+        float delay = m_fCleanupInterval * 1000;
+        if (workLeft)
+            delay = 0;
+            
+        m_iPassTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(CleanupPass, delay);
+    }
+    
+    // Returns the number of entities deleted
+    protected int CleanupType(SCR_EZombieCleanupType type, int budget)
+    {
+        array<IEntity> entities = m_aEntities[type];
+        array<float> trackTimes = m_aTrackTimes[type];
+        array<InventoryItemComponent> inventoryItems = m_aInventoryItems[type];
+        float now = GetGame().GetWorld().GetWorldTime();
+        float maxAge = m_aMaxAges[type];
+        float protectionSq = m_fProtectionDistance * m_fProtectionDistance;
+        
+        // Score everything once, -1 marks entities that have to stay
+        m_aScores.Clear();
+        int expired = 0;
+        int onGroundCount = 0;
+        int index = 0;
+        while (index < entities.Count())
+        {
+            IEntity entity = entities[index];
+            if (!entity)
+            {
+                RemoveAt(type, index);
+                continue;
+            }
+            
+            float score = -1;
+            
+            // Loot is only garbage while it lies on the ground, not while someone carries it. A carried
+            // item's clock restarts every pass, so its age counts from when it was dropped.
+            bool onGround = !inventoryItems[index] || !inventoryItems[index].GetParentSlot();
+            if (onGround)
+                onGroundCount++;
+            else
+                trackTimes[index] = now;
+                
+            float distanceSq = GetNearestPlayerDistanceSq(entity.GetOrigin());
+            if (onGround && distanceSq >= protectionSq)
+            {
+                float ageFactor = (now - trackTimes[index]) / maxAge;
+                float distanceFactor = Math.Min(Math.Sqrt(distanceSq) / (m_fProtectionDistance * 4), 1);
+                score = ageFactor + distanceFactor;
+                
+                // Expired entities go before anything that is merely over the cap
+                if (ageFactor >= 1)
+                {
+                    score += EXPIRED_PRIORITY;
+                    expired++;
+                }
+            }
+            
+            m_aScores.Insert(score);
+            index++;
+        }
+        
+        int toDelete = Math.Max(onGroundCount - m_aCaps[type], expired);
+        toDelete = Math.Min(toDelete, budget);
+        
+        int deleted = 0;
+        while (deleted < toDelete)
+        {
+            // Budgets are small, repeated selection of the worst beats sorting the whole list
+            int worst = -1;
+            for (int candidate = 0; candidate < m_aScores.Count(); candidate++)
+            {
+                if (m_aScores[candidate] >= 0 && (worst == -1 || m_aScores[candidate] > m_aScores[worst]))
+                    worst = candidate;
+            }
+            
+            if (worst == -1)
+                break;
+                
+            SCR_EntityHelper.DeleteEntityAndChildren(entities[worst]);
+            RemoveAt(type, worst);
+            m_aScores[worst] = m_aScores[m_aScores.Count() - 1];
+            m_aScores.Remove(m_aScores.Count() - 1);
+            deleted++;
+        }
+        
+        m_aDeletedCounts[type] = m_aDeletedCounts[type] + deleted;
+        return deleted;
+    }
+    
+    protected void RemoveAt(SCR_EZombieCleanupType type, int index)
+    {
+        array<IEntity> entities = m_aEntities[type];
+        array<float> trackTimes = m_aTrackTimes[type];
+        array<InventoryItemComponent> inventoryItems = m_aInventoryItems[type];
+        
+        int last = entities.Count() - 1;
+        entities[index] = entities[last];
+        trackTimes[index] = trackTimes[last];
+        inventoryItems[index] = inventoryItems[last];
+        
+        entities.Remove(last);
+        trackTimes.Remove(last);
+        inventoryItems.Remove(last);
+    }
+    
+    protected void CollectPlayerPositions()
+    {
+        m_aPlayerIds.Clear();
+        m_aPlayerPositions.Clear();
+        
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        playerManager.GetPlayers(m_aPlayerIds);
+        foreach (int playerId : m_aPlayerIds)
+        {
+            IEntity playerEntity = playerManager.GetPlayerControlledEntity(playerId);
+            if (playerEntity)
+                m_aPlayerPositions.Insert(playerEntity.GetOrigin());
+        }
+    }
+    
+    protected float GetNearestPlayerDistanceSq(vector position)
+    {
+        float nearestSq = float.MAX;
+        foreach (vector playerPosition : m_aPlayerPositions)
+        {
+            nearestSq = Math.Min(nearestSq, vector.DistanceSq(position, playerPosition));
+        }
+        
+        return nearestSq;
+    }
+}
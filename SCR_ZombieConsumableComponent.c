@@ -0,0 +1,144 @@
+enum SCR_EZombieConsumableEffect
+{
+    HUNGER,
+    THIRST,
+    HEALTH,
+    INFECTION,
+    CURE_INFECTION,
+    STOP_BLEEDING,
+    PAIN_RELIEF,
+    STAMINA
+}
+
+[BaseContainerProps()]
+class SCR_ZombieConsumableEffect
+{
+    [Attribute("0", UIWidgets.ComboBox, "What the effect changes", "", ParamEnumArray.FromEnum(SCR_EZombieConsumableEffect))]
+    SCR_EZombieConsumableEffect m_eType;
+    
+    [Attribute("0", UIWidgets.Auto, "Amount restored, for infection negative values reduce it")]
+    float m_fAmount;
+    
+    [Attribute("0", UIWidgets.Auto, "Duration in seconds of timed effects such as pain relief")]
+    float m_fDuration;
+    
+    void SCR_ZombieConsumableEffect(SCR_EZombieConsumableEffect type = SCR_EZombieConsumableEffect.HUNGER, float amount = 0, float duration = 0)
+    {
+        m_eType = type;
+        m_fAmount = amount;
+        m_fDuration = duration;
+    }
+}
+
+// Item side of the consumable pipeline: a use time and a list of effect descriptors. Timing,
+// component lookups and the effects themselves are handled by SCR_ZombieConsumableExecutor.
+class SCR_ZombieConsumableComponent : SCR_ConsumableItemComponent
+{
+    [Attribute("", UIWidgets.Object, "Effects applied on consumption, when empty they are built from the item's own settings")]
+    protected ref array<ref SCR_ZombieConsumableEffect> m_aEffects;
+    
+    protected InventoryItemComponent m_InventoryItem;
+    
+    override void OnPostInit(IEntity owner)
+    {
+        super.OnPostInit(owner);
+        
+        m_InventoryItem = InventoryItemComponent.Cast(owner.FindComponent(InventoryItemComponent));
+        
+        if (!m_aEffects || m_aEffects.IsEmpty())
+            RebuildEffects();
+    }
+    
+    array<ref SCR_ZombieConsumableEffect> GetEffects()
+    {
+        return m_aEffects;
+    }
+    
+    // Time in seconds the consumption takes
+    float GetUseTime()
+    {
+        return 0;
+    }
+    
+    string GetUseSound()
+    {
+        return string.Empty;
+    }
+    
+    string GetProgressHint()
+    {
+        return "Consuming...";
+    }
+    
+    // Usable on an infected player even when none of the effects is needed
+    bool IsUsableWhileInfected()
+    {
+        return false;
+    }
+    
+    override bool CanConsume(IEntity user)
+    {
+        if (!super.CanConsume(user))
+            return false;
+            
+        return SCR_ZombieConsumableExecutor.GetInstance().CanConsume(this, user);
+    }
+    
+    override void StartConsumption(IEntity user)
+    {
+        if (!CanConsume(user))
+            return;
+            
+        SCR_ZombieConsumableExecutor.GetInstance().Begin(this, user);
+    }
+    
+    override void OnConsume(IEntity user)
+    {
+        super.OnConsume(user);
+        
+        SCR_ZombieConsumableExecutor.GetInstance().ApplyEffects(this, user);
+        RemoveFromInventory();
+    }
+    
+    void CancelConsumption()
+    {
+        SCR_ZombieConsumableExecutor executor = SCR_ZombieConsumableExecutor.FindInstance();
+        if (executor)
+            executor.Cancel(this);
+    }
+    
+    bool IsConsuming()
+    {
+        return SCR_ZombieConsumableExecutor.GetInstance().IsConsuming(this);
+    }
+    
+    float GetConsumptionProgress()
+    {
+        return SCR_ZombieConsumableExecutor.GetInstance().GetProgress(this);
+    }
+    
+    // Item types describe their legacy attributes as effects here
+    protected void BuildEffects(notnull array<ref SCR_ZombieConsumableEffect> effects)
+    {
+    }
+    
+    protected void RebuildEffects()
+    {
+        m_aEffects = new array<ref SCR_ZombieConsumableEffect>();
+        BuildEffects(m_aEffects);
+    }
+    
+    protected void RemoveFromInventory()
+    {
+        if (!m_InventoryItem)
+            return;
+            
+        InventoryStorageManagerComponent storageManager = m_InventoryItem.GetStorageManager();
+        if (storageManager)
+            storageManager.TryRemoveItemFromInventory(GetOwner());
+            
+        SCR_ZombieCleanupManager cleanup = SCR_ZombieCleanupManager.GetInstance();
+        if (cleanup)
+            cleanup.Track(GetOwner(), SCR_EZombieCleanupType.LEFTOVER);
+    }
+}
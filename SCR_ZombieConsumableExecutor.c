@@ -0,0 +1,351 @@
+// Components of a consuming player, resolved once per user instead of per effect
+class SCR_ZombieConsumerHandles
+{
+    SCR_ZombieSurvivalComponent m_Survival;
+    DamageManagerComponent m_DamageManager;
+    SCR_CharacterControllerComponent m_Controller;
+    AudioComponent m_Audio;
+}
+
+// Runs every food, water and medical consumption. In-progress consumptions live in one table of
+// parallel arrays with one timer wheel entry each; a player consumes one item at a time.
+class SCR_ZombieConsumableExecutor
+{
+    protected static ref SCR_ZombieConsumableExecutor s_Instance;
+    
+    protected ref array<IEntity> m_aUsers = new array<IEntity>();
+    protected ref array<SCR_ZombieConsumableComponent> m_aItems = new array<SCR_ZombieConsumableComponent>();
+    protected ref array<float> m_aStartTimes = new array<float>();
+    protected ref array<int> m_aTimers = new array<int>();
+    
+    protected ref map<IEntity, ref SCR_ZombieConsumerHandles> m_mHandles = new map<IEntity, ref SCR_ZombieConsumerHandles>();
+    
+    static SCR_ZombieConsumableExecutor GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieConsumableExecutor();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieConsumableExecutor FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        if (!s_Instance)
+            return;
+            
+        foreach (int timer : s_Instance.m_aTimers)
+        {
+            SCR_ZombieTimerWheel.CancelTimer(timer);
+        }
+        
+        s_Instance = null;
+    }
+    
+    int GetActiveCount()
+    {
+        return m_aUsers.Count();
+    }
+    
+    // An item is usable when the user is free and at least one of its effects would change something
+    bool CanConsume(SCR_ZombieConsumableComponent item, IEntity user)
+    {
+        if (!user || m_aUsers.Find(user) != -1 || m_aItems.Find(item) != -1)
+            return false;
+            
+        array<ref SCR_ZombieConsumableEffect> effects = item.GetEffects();
+        if (!effects)
+            return false;
+            
+        // Medical items stay usable on any infected player, whatever their effects
+        SCR_ZombieInfectionManager infectionManager = SCR_ZombieInfectionManager.GetInstance();
+        if (item.IsUsableWhileInfected() && infectionManager && infectionManager.IsInfected(user))
+            return true;
+            
+        SCR_ZombieConsumerHandles handles = GetHandles(user);
+        foreach (SCR_ZombieConsumableEffect effect : effects)
+        {
+            if (IsNeeded(effect, user, handles))
+                return true;
+        }
+        
+        return false;
+    }
+    
+    void Begin(SCR_ZombieConsumableComponent item, IEntity user)
+    {
+        SCR_ZombieConsumerHandles handles = GetHandles(user);
+        
+        // Play consumption sound
+        string sound = item.GetUseSound();
+        if (sound != "" && handles.m_Audio)
+            handles.m_Audio.PlaySound(sound);
+            
+        // Routed to the owning client, this runs on the server
+        SCR_ZombiePlayerStateComponent.ShowHint(user, item.GetProgressHint(), "CONSUMING", 3.0);
+        
+        m_aUsers.Insert(user);
+        m_aItems.Insert(item);
+        m_aStartTimes.Insert(GetGame().GetWorld().GetWorldTime());
+        m_aTimers.Insert(SCR_ZombieTimerWheel.GetInstance().Schedule(Complete, item.GetUseTime() * 1000, false, item));
+    }
+    
+    void Cancel(SCR_ZombieConsumableComponent item)
+    {
+        int slot = m_aItems.Find(item);
+        if (slot == -1)
+            return;
+            
+        SCR_ZombieTimerWheel.CancelTimer(m_aTimers[slot]);
+        RemoveSlot(slot);
+    }
+    
+    // Drops a leaving player's consumption and cached handles
+    void ForgetUser(IEntity user)
+    {
+        int slot = m_aUsers.Find(user);
+        if (slot != -1)
+        {
+            SCR_ZombieTimerWheel.CancelTimer(m_aTimers[slot]);
+            RemoveSlot(slot);
+        }
+        
+        m_mHandles.Remove(user);
+    }
+    
+    bool IsConsuming(SCR_ZombieConsumableComponent item)
+    {
+        return m_aItems.Find(item) != -1;
+    }
+    
+    float GetProgress(SCR_ZombieConsumableComponent item)
+    {
+        int slot = m_aItems.Find(item);
+        if (slot == -1)
+            return 0.0;
+            
+        float useTime = item.GetUseTime() * 1000;
+        if (useTime <= 0)
+            return 1.0;
+            
+        float elapsed = GetGame().GetWorld().GetWorldTime() - m_aStartTimes[slot];
+        return Math.Clamp(elapsed / useTime, 0.0, 1.0);
+    }
+    
+    void ApplyEffects(SCR_ZombieConsumableComponent item, IEntity user)
+    {
+        array<ref SCR_ZombieConsumableEffect> effects = item.GetEffects();
+        if (!effects || !user)
+            return;
+            
+        SCR_ZombieConsumerHandles handles = GetHandles(user);
+        foreach (SCR_ZombieConsumableEffect effect : effects)
+        {
+            ApplyEffect(effect, user, handles);
+        }
+    }
+    
+    protected void Complete(Managed context)
+    {
+        SCR_ZombieConsumableComponent item = SCR_ZombieConsumableComponent.Cast(context);
+        int slot = m_aItems.Find(item);
+        if (slot == -1)
+            return;
+            
+        IEntity user = m_aUsers[slot];
+        RemoveSlot(slot);
+        
+        if (user && item)
+            item.OnConsume(user);
+    }
+    
+    protected void RemoveSlot(int slot)
+    {
+        int last = m_aUsers.Count() - 1;
+        if (slot != last)
+        {
+            m_aUsers[slot] = m_aUsers[last];
+            m_aItems[slot] = m_aItems[last];
+            m_aStartTimes[slot] = m_aStartTimes[last];
+            m_aTimers[slot] = m_aTimers[last];
+        }
+        
+        m_aUsers.Remove(last);
+        m_aItems.Remove(last);
+        m_aStartTimes.Remove(last);
+        m_aTimers.Remove(last);
+    }
+    
+    protected SCR_ZombieConsumerHandles GetHandles(IEntity user)
+    {
+        SCR_ZombieConsumerHandles handles = m_mHandles.Get(user);
+        if (handles)
+            return handles;
+            
+        handles = new SCR_ZombieConsumerHandles();
+        handles.m_Survival = SCR_ZombieSurvivalComponent.Cast(user.FindComponent(SCR_ZombieSurvivalComponent));
+        handles.m_DamageManager = DamageManagerComponent.Cast(user.FindComponent(DamageManagerComponent));
+        handles.m_Controller = SCR_CharacterControllerComponent.Cast(user.FindComponent(SCR_CharacterControllerComponent));
+        handles.m_Audio = AudioComponent.Cast(user.FindComponent(AudioComponent));
+        m_mHandles.Insert(user, handles);
+        return handles;
+    }
+    
+    // Pain relief and stamina are extras, they never make an item usable on their own
+    protected bool IsNeeded(SCR_ZombieConsumableEffect effect, IEntity user, SCR_ZombieConsumerHandles handles)
+    {
+        SCR_ZombieInfectionManager infectionManager = SCR_ZombieInfectionManager.GetInstance();
+        
+        switch (effect.m_eType)
+        {
+            case SCR_EZombieConsumableEffect.HUNGER:
+                return handles.m_Survival && handles.m_Survival.GetHunger() < 100.0;
+            case SCR_EZombieConsumableEffect.THIRST:
+                return handles.m_Survival && handles.m_Survival.GetThirst() < 100.0;
+            case SCR_EZombieConsumableEffect.HEALTH:
+                return handles.m_DamageManager && handles.m_DamageManager.GetHealth() < handles.m_DamageManager.GetHealthMax();
+            case SCR_EZombieConsumableEffect.INFECTION:
+                return effect.m_fAmount < 0 && infectionManager && infectionManager.IsInfected(user);
+            case SCR_EZombieConsumableEffect.CURE_INFECTION:
+                return infectionManager && infectionManager.IsInfected(user);
+            case SCR_EZombieConsumableEffect.STOP_BLEEDING:
+            {
+                // Engine bleeding from wounds as well as the status effect from zombie hits
+                if (handles.m_DamageManager && handles.m_DamageManager.IsDamagedOverTime(EDamageType.BLEEDING))
+                    return true;
+                    
+                return SCR_ZombieStatusEffectManager.GetInstance().HasEffect(user, SCR_EZombieStatusEffect.BLEEDING);
+            }
+        }
+        
+        return false;
+    }
+    
+    protected void ApplyEffect(SCR_ZombieConsumableEffect effect, IEntity user, SCR_ZombieConsumerHandles handles)
+    {
+        float amount = effect.m_fAmount;
+        
+        switch (effect.m_eType)
+        {
+            case SCR_EZombieConsumableEffect.HUNGER:
+            {
+                if (handles.m_Survival)
+                {
+                    handles.m_Survival.AddHunger(amount);
+                    ShowResult(user, "Hunger restored: +" + amount.ToString());
+                }
+                
+                break;
+            }
+            case SCR_EZombieConsumableEffect.THIRST:
+            {
+                if (handles.m_Survival)
+                {
+                    handles.m_Survival.AddThirst(amount);
+                    ShowResult(user, "Thirst restored: +" + amount.ToString());
+                }
+                
+                break;
+            }
+            case SCR_EZombieConsumableEffect.HEALTH:
+            {
+                DamageManagerComponent dmgMgr = handles.m_DamageManager;
+                if (dmgMgr && amount > 0)
+                {
+                    dmgMgr.SetHealth(Math.Min(dmgMgr.GetHealthMax(), dmgMgr.GetHealth() + amount));
+                    ShowResult(user, "Health restored: +" + amount.ToString());
+                }
+                
+                break;
+            }
+            case SCR_EZombieConsumableEffect.INFECTION:
+            {
+                ApplyInfection(user, amount, handles);
+                break;
+            }
+            case SCR_EZombieConsumableEffect.CURE_INFECTION:
+            {
+                SCR_ZombieInfectionManager infectionManager = SCR_ZombieInfectionManager.GetInstance();
+                if (infectionManager && infectionManager.IsInfected(user))
+                {
+                    infectionManager.Cure(user);
+                    ShowResult(user, "Infection cured!");
+                }
+                
+                break;
+            }
+            case SCR_EZombieConsumableEffect.STOP_BLEEDING:
+            {
+                if (handles.m_DamageManager)
+                    handles.m_DamageManager.ClearDamageOverTime(EDamageType.BLEEDING);
+                    
+                SCR_ZombieStatusEffectManager.GetInstance().RemoveEffect(user, SCR_EZombieStatusEffect.BLEEDING);
+                ShowResult(user, "Bleeding stopped!");
+                break;
+            }
+            case SCR_EZombieConsumableEffect.PAIN_RELIEF:
+            {
+                // Timed status effect, expires through the shared status effect heap
+                SCR_ZombieStatusEffectManager.GetInstance().AddEffect(user, SCR_EZombieStatusEffect.PAIN_RELIEF, effect.m_fDuration);
+                ShowResult(user, "Pain relief applied for " + (effect.m_fDuration / 60).ToString() + " minutes");
+                break;
+            }
+            case SCR_EZombieConsumableEffect.STAMINA:
+            {
+                SCR_CharacterControllerComponent controller = handles.m_Controller;
+                if (controller && amount > 0)
+                {
+                    controller.SetStamina(Math.Min(controller.GetMaxStamina(), controller.GetStamina() + amount));
+                    ShowResult(user, "Stamina restored: +" + amount.ToString());
+                }
+                
+                break;
+            }
+        }
+    }
+    
+    // Positive amounts infect, e.g. contaminated water, negative ones treat an existing infection
+    protected void ApplyInfection(IEntity user, float amount, SCR_ZombieConsumerHandles handles)
+    {
+        SCR_ZombieInfectionManager infectionManager = SCR_ZombieInfectionManager.GetInstance();
+        
+        if (amount < 0)
+        {
+            if (infectionManager && infectionManager.IsInfected(user))
+            {
+                infectionManager.AddInfection(user, amount);
+                ShowResult(user, "Infection reduced: " + amount.ToString());
+            }
+            
+            return;
+        }
+        
+        if (infectionManager && infectionManager.AddInfection(user, amount))
+        {
+            ShowResult(user, "You feel sick from what you consumed!");
+            return;
+        }
+        
+        // If no infection system, apply direct damage
+        if (handles.m_DamageManager)
+        {
+            DamageParams params = new DamageParams();
+            params.Damage = amount * 0.5; // Convert infection to damage
+            params.DamageType = EDamageType.BIOLOGICAL;
+            
+            handles.m_DamageManager.InflictDamage(params);
+            ShowResult(user, "What you consumed makes you ill!");
+        }
+    }
+    
+    protected void ShowResult(IEntity user, string message)
+    {
+        // Routed to the owning client, this runs on the server
+        SCR_ZombiePlayerStateComponent.ShowHint(user, message, "CONSUMPTION_RESULT", 2.0);
+    }
+}
@@ -0,0 +1,282 @@
+[BaseContainerProps()]
+class SCR_ZombieArchetype
+{
+    [Attribute("", UIWidgets.ResourceNamePicker, "Zombie prefab", "et")]
+    ResourceName m_Prefab;
+    
+    [Attribute("1.0", UIWidgets.Auto, "Relative weight within the zone")]
+    float m_fWeight;
+}
+
+[BaseContainerProps()]
+class SCR_ZombieZone
+{
+    [Attribute("0", UIWidgets.Auto, "Zone ID as stored in the density raster, 0-255")]
+    int m_iId;
+    
+    [Attribute("", UIWidgets.EditBox, "Name used in logs")]
+    string m_sName;
+    
+    [Attribute("", UIWidgets.Object, "Zombie types spawned in this zone, the manager's prefab when empty")]
+    ref array<ref SCR_ZombieArchetype> m_aArchetypes;
+    
+    [Attribute("50", UIWidgets.Auto, "Maximum number of live zombies in this zone, 0 for none at all")]
+    int m_iCap;
+}
+
+[BaseContainerProps(configRoot: true)]
+class SCR_ZombieZoneConfig
+{
+    [Attribute("", UIWidgets.Object, "Zones referenced by the density raster")]
+    ref array<ref SCR_ZombieZone> m_aZones;
+}
+
+// Per map spawn density and zones. The raster is a flat grid of cells with an 8-bit density and an
+// 8-bit zone ID, two cells per int exactly as stored on disk, so sampling a position is one index
+// computation. Zones map to archetype mixes and live caps from a config.
+class SCR_ZombieDensityMap
+{
+    static const int RASTER_MAGIC = 0x5A44454E;
+    static const int RASTER_VERSION = 1;
+    static const int MAX_ZONES = 256;
+    static const int MAX_DENSITY = 255;
+    
+    protected static ref SCR_ZombieDensityMap s_Instance;
+    
+    protected int m_iWidth;
+    protected int m_iHeight;
+    protected float m_fCellSize;
+    protected float m_fOriginX;
+    protected float m_fOriginZ;
+    protected ref array<int> m_aCells = new array<int>();
+    protected bool m_bLoaded;
+    
+    // Indexed by zone ID, -1 caps mark zones missing from the config
+    protected ref array<int> m_aZoneCaps = new array<int>();
+    protected ref array<int> m_aZoneCounts = new array<int>();
+    protected ref array<string> m_aZoneNames = new array<string>();
+    protected ref array<int> m_aArchetypeStarts = new array<int>();
+    protected ref array<int> m_aArchetypeCounts = new array<int>();
+    
+    // Archetypes of all zones back to back, cumulative weights per zone
+    protected ref array<ResourceName> m_aArchetypePrefabs = new array<ResourceName>();
+    protected ref array<float> m_aCumulativeWeights = new array<float>();
+    
+    static SCR_ZombieDensityMap GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieDensityMap();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieDensityMap FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        s_Instance = null;
+    }
+    
+    void SCR_ZombieDensityMap()
+    {
+        for (int zone = 0; zone < MAX_ZONES; zone++)
+        {
+            m_aZoneCaps.Insert(-1);
+            m_aZoneCounts.Insert(0);
+            m_aZoneNames.Insert(string.Empty);
+            m_aArchetypeStarts.Insert(0);
+            m_aArchetypeCounts.Insert(0);
+        }
+    }
+    
+    bool IsLoaded()
+    {
+        return m_bLoaded;
+    }
+    
+    int GetWidth()
+    {
+        return m_iWidth;
+    }
+    
+    int GetHeight()
+    {
+        return m_iHeight;
+    }
+    
+    // Header: magic, version, width, height, cell size, origin x, origin z; then the packed cells
+    bool Load(string rasterPath, ResourceName zoneConfigPath)
+    {
+        m_bLoaded = false;
+        if (rasterPath.IsEmpty() || !FileIO.FileExists(rasterPath))
+            return false;
+            
+        FileHandle file = FileIO.OpenFile(rasterPath, FileMode.READ);
+        if (!file)
+            return false;
+            
+        int magic;
+        int version;
+        file.Read(magic, 4);
+        file.Read(version, 4);
+        if (magic != RASTER_MAGIC || version != RASTER_VERSION)
+        {
+            Print(string.Format("[Zombies] %1 is not a density raster", rasterPath), LogLevel.ERROR);
+            file.Close();
+            return false;
+        }
+        
+        file.Read(m_iWidth, 4);
+        file.Read(m_iHeight, 4);
+        file.Read(m_fCellSize, 4);
+        file.Read(m_fOriginX, 4);
+        file.Read(m_fOriginZ, 4);
+        
+        int wordCount = (m_iWidth * m_iHeight + 1) / 2;
+        m_aCells.Clear();
+        m_aCells.Reserve(wordCount);
+        for (int i = 0; i < wordCount; i++)
+        {
+            int word;
+            if (file.Read(word, 4) < 4)
+            {
+                Print(string.Format("[Zombies] Density raster %1 is truncated", rasterPath), LogLevel.ERROR);
+                file.Close();
+                return false;
+            }
+            
+            m_aCells.Insert(word);
+        }
+        
+        file.Close();
+        
+        // Without zone caps every cell would be at its cap, spawning falls back to uniform instead
+        if (!LoadZones(zoneConfigPath))
+            return false;
+            
+        m_bLoaded = m_fCellSize > 0;
+        return m_bLoaded;
+    }
+    
+    // Returns the packed cell, density in the low byte and zone ID in the high byte; 0 outside the map
+    int Sample(vector position)
+    {
+        int x = Math.Floor((position[0] - m_fOriginX) / m_fCellSize);
+        int z = Math.Floor((position[2] - m_fOriginZ) / m_fCellSize);
+        if (x < 0 || z < 0 || x >= m_iWidth || z >= m_iHeight)
+            return 0;
+            
+        int index = z * m_iWidth + x;
+        return (m_aCells[index >> 1] >> ((index & 1) * 16)) & 0xFFFF;
+    }
+    
+    static int GetDensity(int cell)
+    {
+        return cell & 0xFF;
+    }
+    
+    static int GetZone(int cell)
+    {
+        return (cell >> 8) & 0xFF;
+    }
+    
+    // Unconfigured zones spawn nothing, the raster and config are expected to match
+    bool HasZoneBudget(int zone)
+    {
+        return m_aZoneCounts[zone] < m_aZoneCaps[zone];
+    }
+    
+    void AddZoneCount(int zone, int delta)
+    {
+        m_aZoneCounts[zone] = Math.Max(m_aZoneCounts[zone] + delta, 0);
+    }
+    
+    void ResetZoneCounts()
+    {
+        for (int zone = 0; zone < MAX_ZONES; zone++)
+        {
+            m_aZoneCounts[zone] = 0;
+        }
+    }
+    
+    int GetZoneCount(int zone)
+    {
+        return m_aZoneCounts[zone];
+    }
+    
+    string GetZoneName(int zone)
+    {
+        return m_aZoneNames[zone];
+    }
+    
+    // Empty when the zone has no archetypes of its own
+    ResourceName DrawArchetype(int zone)
+    {
+        int count = m_aArchetypeCounts[zone];
+        if (count == 0)
+            return ResourceName.Empty;
+            
+        int start = m_aArchetypeStarts[zone];
+        float roll = Math.RandomFloat(0, m_aCumulativeWeights[start + count - 1]);
+        for (int i = start; i < start + count - 1; i++)
+        {
+            if (roll < m_aCumulativeWeights[i])
+                return m_aArchetypePrefabs[i];
+        }
+        
+        return m_aArchetypePrefabs[start + count - 1];
+    }
+    
+    protected bool LoadZones(ResourceName zoneConfigPath)
+    {
+        Resource resource = Resource.Load(zoneConfigPath);
+        if (!resource || !resource.IsValid())
+        {
+            Print(string.Format("[Zombies] Zone config %1 could not be loaded", zoneConfigPath), LogLevel.ERROR);
+            return false;
+        }
+        
+        SCR_ZombieZoneConfig config = SCR_ZombieZoneConfig.Cast(BaseContainerTools.CreateInstanceFromContainer(resource.GetResource().ToBaseContainer()));
+        if (!config || !config.m_aZones)
+        {
+            Print(string.Format("[Zombies] %1 is not a zone config or has no zones", zoneConfigPath), LogLevel.ERROR);
+            return false;
+        }
+            
+        m_aArchetypePrefabs.Clear();
+        m_aCumulativeWeights.Clear();
+        
+        foreach (SCR_ZombieZone zone : config.m_aZones)
+        {
+            if (!zone || zone.m_iId < 0 || zone.m_iId >= MAX_ZONES)
+                continue;
+                
+            int id = zone.m_iId;
+            m_aZoneCaps[id] = zone.m_iCap;
+            m_aZoneNames[id] = zone.m_sName;
+            m_aArchetypeStarts[id] = m_aArchetypePrefabs.Count();
+            m_aArchetypeCounts[id] = 0;
+            
+            if (!zone.m_aArchetypes)
+                continue;
+                
+            float total = 0;
+            foreach (SCR_ZombieArchetype archetype : zone.m_aArchetypes)
+            {
+                if (!archetype || archetype.m_Prefab.IsEmpty() || archetype.m_fWeight <= 0)
+                    continue;
+                    
+                total += archetype.m_fWeight;
+                m_aArchetypePrefabs.Insert(archetype.m_Prefab);
+                m_aCumulativeWeights.Insert(total);
+                m_aArchetypeCounts[id] = m_aArchetypeCounts[id] + 1;
+            }
+        }
+        
+        return true;
+    }
+}
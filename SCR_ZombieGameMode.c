@@ -1,7 +1,7 @@
 [EntityEditorProps(category: "GameScripted/GameMode", description: "DayZ-like zombie game mode")]
 class SCR_ZombieGameMode : SCR_GameModeBase
 {
-    [Attribute("50", UIWidgets.Auto, "Number of zombies to spawn initially")]
+    [Attribute("50", UIWidgets.Auto, "Number of zombies seeded across the map at start, they materialize as players approach")]
     protected int m_iInitialZombieCount;
     
     [Attribute(defvalue: "0", uiwidget: UIWidgets.CheckBox, desc: "Enable player infection system")]
@@ -10,18 +10,62 @@ class SCR_ZombieGameMode : SCR_GameModeBase
     [Attribute(defvalue: "0", uiwidget: UIWidgets.CheckBox, desc: "Enable hunger and thirst")]
     protected bool m_bEnableSurvival;
     
+    [Attribute(defvalue: "0", uiwidget: UIWidgets.CheckBox, desc: "Snapshot loot, population and player state and restore it after a restart")]
+    protected bool m_bEnablePersistence;
+    
+    [Attribute("300", UIWidgets.Auto, "Interval in seconds between persistence snapshots")]
+    protected float m_fSnapshotInterval;
+    
+    [Attribute("", UIWidgets.ResourceNamePicker, "Shared loot table config", "conf")]
+    protected ResourceName m_LootTableConfig;
+    
+    [Attribute("150.0", UIWidgets.Auto, "Distance in meters from a player at which loot items are created")]
+    protected float m_fLootStreamRadius;
+    
+    [Attribute("30.0", UIWidgets.Auto, "Extra distance in meters before streamed loot items are removed again")]
+    protected float m_fLootStreamHysteresis;
+    
+    [Attribute("2.0", UIWidgets.Auto, "Interval in seconds between loot streaming updates")]
+    protected float m_fLootStreamInterval;
+    
+    [Attribute(defvalue: "0", uiwidget: UIWidgets.CheckBox, desc: "Periodically log performance statistics of the zombie systems")]
+    protected bool m_bLogPerformanceStats;
+    
+    [Attribute("60", UIWidgets.Auto, "Interval in seconds between performance statistics logs")]
+    protected float m_fStatsLogInterval;
+    
+    protected int m_iStatsTimer;
+    protected int m_iLootStreamTimer;
+    
+    // Reused between loot streaming updates
+    protected ref array<int> m_aLootPlayerIds = new array<int>();
+    protected ref array<vector> m_aLootPlayerPositions = new array<vector>();
+    
     protected ref ZombieManager m_ZombieManager;
     protected ref SCR_ZombieSurvivalManager m_SurvivalManager;
     protected ref SCR_ZombieInfectionManager m_InfectionManager;
+    protected ref SCR_ZombieCleanupManager m_CleanupManager;
     
     override void OnGameModeStart()
     {
         super.OnGameModeStart();
         
+        // Start the shared timer wheel before any subsystem schedules on it
+        SCR_ZombieTimerWheel timers = SCR_ZombieTimerWheel.GetInstance();
+        
         // Create and initialize zombie manager
         m_ZombieManager = new ZombieManager();
         GetGame().GetWorld().AddComponent(m_ZombieManager);
         
+        // Loot spawners exist with or without survival, their tables and streaming are set up here.
+        // The tables load before persistence starts, restored rolls are stored as table slots.
+        SCR_ZombieLootTableManager.GetInstance().Load(m_LootTableConfig);
+        m_iLootStreamTimer = timers.Schedule(UpdateLootStreaming, m_fLootStreamInterval * 1000, true);
+        
+        // Corpses, dropped loot and leftovers
+        m_CleanupManager = new SCR_ZombieCleanupManager();
+        GetGame().GetWorld().AddComponent(m_CleanupManager);
+        
         // Create survival manager if enabled
         if (m_bEnableSurvival)
         {
@@ -38,6 +82,16 @@ class SCR_ZombieGameMode : SCR_GameModeBase
         
         // Set up world
         SetupWorld();
+        
+        // Warm start from the last snapshot, streamed in over the following frames
+        if (m_bEnablePersistence)
+            SCR_ZombiePersistence.GetInstance().Start(m_ZombieManager, m_fSnapshotInterval);
+            
+        // Warm-up, the initial population is seeded in the background before players arrive
+        m_ZombieManager.StartSeeding(m_iInitialZombieCount);
+        
+        if (m_bLogPerformanceStats)
+            m_iStatsTimer = timers.Schedule(LogPerformanceStats, m_fStatsLogInterval * 1000, true);
     }
     
     override void OnGameModeEnd()
@@ -53,6 +107,144 @@ class SCR_ZombieGameMode : SCR_GameModeBase
             
         if (m_InfectionManager)
             GetGame().GetWorld().RemoveComponent(m_InfectionManager);
+            
+        if (m_CleanupManager)
+            GetGame().GetWorld().RemoveComponent(m_CleanupManager);
+            
+        SCR_ZombieTimerWheel.CancelTimer(m_iStatsTimer);
+        SCR_ZombieTimerWheel.CancelTimer(m_iLootStreamTimer);
+        SCR_ZombiePersistence.Shutdown();
+        SCR_ZombieAudioDirector.Shutdown();
+        SCR_ZombieMovementLOD.Shutdown();
+        SCR_ZombieNetRelevancy.Shutdown();
+        SCR_ZombieHordeManager.Shutdown();
+        SCR_ZombieAttackSlots.Shutdown();
+        SCR_ZombieDensityMap.Shutdown();
+        SCR_ZombieInteriorSlots.Shutdown();
+        SCR_ZombieConsumableExecutor.Shutdown();
+        SCR_ZombieStatusEffectManager.Shutdown();
+        SCR_ZombieStatModifierManager.Shutdown();
+        SCR_ZombieLootTableManager.Shutdown();
+        SCR_ZombieTimerWheel.Shutdown();
+    }
+    
+    // Item entities only exist around players, spawners elsewhere just keep their rolled item
+    protected void UpdateLootStreaming(Managed context = null)
+    {
+        m_aLootPlayerIds.Clear();
+        m_aLootPlayerPositions.Clear();
+        
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        playerManager.GetPlayers(m_aLootPlayerIds);
+        foreach (int playerId : m_aLootPlayerIds)
+        {
+            IEntity playerEntity = playerManager.GetPlayerControlledEntity(playerId);
+            if (playerEntity)
+                m_aLootPlayerPositions.Insert(playerEntity.GetOrigin());
+        }
+        
+        SCR_ZombieLootSpawnerRegistry.GetInstance().UpdateStreaming(m_aLootPlayerPositions, m_fLootStreamRadius, m_fLootStreamRadius + m_fLootStreamHysteresis);
+    }
+    
+    protected void LogPerformanceStats(Managed context = null)
+    {
+        SCR_ZombieTimerWheel timers = SCR_ZombieTimerWheel.GetInstance();
+        Print(string.Format("[Zombies] Timers: %1 queued, %2 fired last frame, %3 peak per frame, %4 coalesced",
+            timers.GetQueueLength(), timers.GetFiredLastFrame(), timers.GetPeakFiredPerFrame(), timers.GetCoalescedCount()), LogLevel.NORMAL);
+        Print(string.Format("[Zombies] Stat modifiers: %1 engine pushes", SCR_ZombieStatModifierManager.GetInstance().GetEnginePushCount()), LogLevel.NORMAL);
+        
+        SCR_ZombieLootSpawnerRegistry lootSpawners = SCR_ZombieLootSpawnerRegistry.GetInstance();
+        Print(string.Format("[Zombies] Loot respawn queues: %1 food, %2 water, %3 medical",
+            lootSpawners.GetQueueDepth(SCR_EZombieLootCategory.FOOD),
+            lootSpawners.GetQueueDepth(SCR_EZombieLootCategory.WATER),
+            lootSpawners.GetQueueDepth(SCR_EZombieLootCategory.MEDICAL)), LogLevel.NORMAL);
+        Print(string.Format("[Zombies] Loot streaming: %1 materialized spawners", lootSpawners.GetMaterializedCount()), LogLevel.NORMAL);
+        
+        if (m_ZombieManager)
+        {
+            Print(string.Format("[Zombies] Population: %1 live, %2 virtual, seeding %3 percent done in %4 ms",
+                m_ZombieManager.GetZombies().Count(), m_ZombieManager.GetVirtualPopulation().Count(),
+                Math.Round(m_ZombieManager.GetSeedingProgress() * 100), m_ZombieManager.GetSeedingDurationMs()), LogLevel.NORMAL);
+            SCR_ZombieQuotaAllocator quota = m_ZombieManager.GetQuotaAllocator();
+            Print(string.Format("[Zombies] Spawn quota: %1 player clusters, %2 zombie budget, largest deficit %3, %4 spawns allocated",
+                quota.GetClusterCount(), quota.GetTotalBudget(), quota.GetLargestDeficit(), quota.GetAllocatedCount()), LogLevel.NORMAL);
+            Print(string.Format("[Zombies] Despawns: %1 total, %2 percent never seen by a player",
+                m_ZombieManager.GetDespawnCount(), Math.Round(m_ZombieManager.GetDespawnWasteRatio() * 100)), LogLevel.NORMAL);
+            
+            if (SCR_ZombieDensityMap.GetInstance().IsLoaded())
+            {
+                Print(string.Format("[Zombies] Density map: %1 candidates rejected by density, %2 by zone cap",
+                    m_ZombieManager.GetDensityRejectCount(), m_ZombieManager.GetZoneCapRejectCount()), LogLevel.NORMAL);
+            }
+        }
+        
+        SCR_ZombieInteriorSlots interiorSlots = SCR_ZombieInteriorSlots.GetInstance();
+        Print(string.Format("[Zombies] Interior slots: %1 slots in %2 buildings, %3 prefabs baked, %4 interior spawns",
+            interiorSlots.GetSlotCount(), interiorSlots.GetBuildingCount(), interiorSlots.GetBakedPrefabCount(), interiorSlots.GetSpawnCount()), LogLevel.NORMAL);
+        
+        SCR_ZombieMovementLOD movementLOD = SCR_ZombieMovementLOD.GetInstance();
+        Print(string.Format("[Zombies] Movement LOD: %1 full, %2 kinematic, %3 position only, %4 transitions",
+            movementLOD.GetLevelCount(SCR_EZombieMovementLOD.FULL), movementLOD.GetLevelCount(SCR_EZombieMovementLOD.KINEMATIC),
+            movementLOD.GetLevelCount(SCR_EZombieMovementLOD.POSITION_ONLY), movementLOD.GetTransitionCount()), LogLevel.NORMAL);
+        
+        SCR_ZombieHordeManager hordes = SCR_ZombieHordeManager.GetInstance();
+        Print(string.Format("[Zombies] Hordes: %1 hordes with %2 followers, %3 zombies per horde, %4 path requests per second",
+            hordes.GetHordeCount(), hordes.GetFollowerCount(), hordes.GetAverageHordeSize(), hordes.GetPathRequestsPerSecond()), LogLevel.NORMAL);
+        
+        SCR_ZombieAttackSlots attackSlots = SCR_ZombieAttackSlots.GetInstance();
+        Print(string.Format("[Zombies] Attack slots: %1 attacking, %2 queued, %3 overflowing",
+            attackSlots.GetAttackerCount(), attackSlots.GetWaiterCount(), attackSlots.GetOverflowCount()), LogLevel.NORMAL);
+        
+        SCR_ZombieNetRelevancy relevancy = SCR_ZombieNetRelevancy.GetInstance();
+        Print(string.Format("[Zombies] Net relevancy: %1 clients, %2 zombies streamed per client, about %3 B/s per client against %4 B/s unfiltered, %5 stream-ins, %6 stream-outs",
+            relevancy.GetClientCount(), relevancy.GetAverageRelevantCount(), relevancy.GetEstimatedBytesPerClient(),
+            relevancy.GetEstimatedUnfilteredBytesPerClient(), relevancy.GetStreamedInCount(), relevancy.GetStreamedOutCount()), LogLevel.NORMAL);
+        
+        SCR_ZombieAudioDirector audioDirector = SCR_ZombieAudioDirector.GetInstance();
+        Print(string.Format("[Zombies] Audio: %1 zombies, %2 active voices, %3 played, %4 deferred by voice cap, %5 culled out of earshot",
+            audioDirector.GetRegisteredCount(), audioDirector.GetActiveVoiceCount(), audioDirector.GetPlayedCount(),
+            audioDirector.GetDeferredCount(), audioDirector.GetCulledCount()), LogLevel.NORMAL);
+        
+        if (m_CleanupManager)
+        {
+            Print(string.Format("[Zombies] Cleanup: %1/%2 corpses, %3/%4 dropped items, %5/%6 leftovers tracked/deleted, peak %7 deletions per frame",
+                m_CleanupManager.GetTrackedCount(SCR_EZombieCleanupType.CORPSE), m_CleanupManager.GetDeletedCount(SCR_EZombieCleanupType.CORPSE),
+                m_CleanupManager.GetTrackedCount(SCR_EZombieCleanupType.DROPPED_ITEM), m_CleanupManager.GetDeletedCount(SCR_EZombieCleanupType.DROPPED_ITEM),
+                m_CleanupManager.GetTrackedCount(SCR_EZombieCleanupType.LEFTOVER), m_CleanupManager.GetDeletedCount(SCR_EZombieCleanupType.LEFTOVER),
+                m_CleanupManager.GetPeakFrameDeletions()), LogLevel.NORMAL);
+        }
+        
+        if (m_bEnablePersistence)
+        {
+            SCR_ZombiePersistence persistence = SCR_ZombiePersistence.GetInstance();
+            Print(string.Format("[Zombies] Persistence: last snapshot %1 records in %2 chunks, %3 records restored",
+                persistence.GetLastSnapshotRecords(), persistence.GetLastSnapshotChunks(), persistence.GetRestoredRecordCount()), LogLevel.NORMAL);
+        }
+        
+        if (m_SurvivalManager)
+        {
+            Print(string.Format("[Zombies] Loot respawn: %1 slices, worst slice %2 spawners",
+                m_SurvivalManager.GetSliceCount(), m_SurvivalManager.GetPeakSliceSpawners()), LogLevel.NORMAL);
+        }
+        
+        // Owner-only survival and infection replication cost per player
+        array<int> playerIds = new array<int>();
+        GetGame().GetPlayerManager().GetPlayers(playerIds);
+        foreach (int playerId : playerIds)
+        {
+            IEntity playerEntity = GetGame().GetPlayerManager().GetPlayerControlledEntity(playerId);
+            if (!playerEntity)
+                continue;
+                
+            SCR_ZombiePlayerStateComponent playerState = SCR_ZombiePlayerStateComponent.Cast(playerEntity.FindComponent(SCR_ZombiePlayerStateComponent));
+            if (playerState)
+            {
+                Print(string.Format("[Zombies] Player %1 state: %2 messages, about %3 bytes, about %4 B/s (estimated)",
+                    playerId, playerState.GetMessagesSent(), playerState.GetEstimatedBytesSent(), playerState.GetEstimatedBytesPerSecond()), LogLevel.NORMAL);
+                Print(string.Format("[Zombies] Player %1 horde summaries: %2 messages, about %3 bytes (estimated)",
+                    playerId, playerState.GetHordeSummariesSent(), playerState.GetEstimatedHordeBytesSent()), LogLevel.NORMAL);
+            }
+        }
     }
     
     override protected void OnPlayerConnected(int playerId)
@@ -73,6 +265,11 @@ class SCR_ZombieGameMode : SCR_GameModeBase
     
     protected void InitializePlayerEntity(IEntity playerEntity)
     {
+        // Replicated survival and infection state and the far horde summary. It must come with the
+        // player prefab; a component added here would never exist on the clients.
+        if (!playerEntity.FindComponent(SCR_ZombiePlayerStateComponent))
+            Print(string.Format("[Zombies] Player %1 has no SCR_ZombiePlayerStateComponent on its prefab, player state and horde impostors will not reach the client", playerEntity), LogLevel.ERROR);
+            
         // Add survival component if enabled
         if (m_bEnableSurvival)
         {
@@ -84,16 +281,14 @@ class SCR_ZombieGameMode : SCR_GameModeBase
             }
         }
         
-        // Add infection component if enabled
-        if (m_bEnableInfection)
+        // Track infection if enabled, the manager owns the state of every player
+        if (m_bEnableInfection && m_InfectionManager)
         {
-            SCR_ZombieInfectionComponent infectionComp = SCR_ZombieInfectionComponent.Cast(playerEntity.FindComponent(SCR_ZombieInfectionComponent));
-            if (!infectionComp)
-            {
-                infectionComp = new SCR_ZombieInfectionComponent();
-                playerEntity.AddComponent(infectionComp);
-            }
+            m_InfectionManager.RegisterPlayer(playerEntity);
         }
+        
+        if (m_bEnablePersistence)
+            SCR_ZombiePersistence.GetInstance().RestorePlayer(playerEntity);
     }
     
     protected void SetupWorld()
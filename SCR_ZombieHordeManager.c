@@ -0,0 +1,445 @@
+// Groups nearby zombies into hordes so only one of them pathfinds. Every cluster pass leaders claim
+// the free zombies around them; followers skip their own AI and are steered toward the leader with
+// boids-style cohesion, separation and alignment over the neighbours found in a spatial grid.
+// Followers close to a player are released to fight on their own.
+class SCR_ZombieHordeManager
+{
+    static const float CLUSTER_INTERVAL_MS = 2000;
+    static const float STEER_INTERVAL_MS = 250;
+    static const float GRID_CELL_SIZE = 25;
+    static const float HORDE_RADIUS = 20;
+    static const int MAX_HORDE_SIZE = 8;
+    static const float ENGAGE_DISTANCE = 8;
+    static const float NEIGHBOR_RADIUS = 6;
+    static const float SEPARATION_DISTANCE = 1.5;
+    static const float FOLLOW_DISTANCE = 3;
+    static const float MAX_SPEED = 3.5;
+    static const float COHESION_WEIGHT = 0.3;
+    static const float SEPARATION_WEIGHT = 1.5;
+    static const float ALIGNMENT_WEIGHT = 0.5;
+    static const float FOLLOW_WEIGHT = 1.0;
+    
+    protected static ref SCR_ZombieHordeManager s_Instance;
+    
+    protected ref SCR_ZombieSpatialGrid m_Grid = new SCR_ZombieSpatialGrid(GRID_CELL_SIZE);
+    protected ref map<IEntity, int> m_mSlots = new map<IEntity, int>();
+    
+    // Per zombie, dense and swap-removed; a null leader means the zombie runs its own AI
+    protected ref array<IEntity> m_aZombies = new array<IEntity>();
+    protected ref array<CharacterControllerComponent> m_aControllers = new array<CharacterControllerComponent>();
+    protected ref array<int> m_aCellKeys = new array<int>();
+    protected ref array<IEntity> m_aLeaders = new array<IEntity>();
+    protected ref array<vector> m_aLastPositions = new array<vector>();
+    protected ref array<vector> m_aVelocities = new array<vector>();
+    protected ref array<int> m_aClusterPasses = new array<int>();
+    
+    // Per pass scratch
+    protected ref array<Managed> m_aQueryResults = new array<Managed>();
+    protected ref array<vector> m_aPlayerPositions = new array<vector>();
+    protected ref array<int> m_aPlayerIds = new array<int>();
+    
+    protected int m_iClusterTimer;
+    protected int m_iSteerTimer;
+    protected int m_iClusterPass;
+    protected int m_iHordeCount;
+    protected int m_iFollowerCount;
+    
+    protected int m_iPathRequests;
+    protected float m_fStatsStartTime = -1;
+    
+    static SCR_ZombieHordeManager GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieHordeManager();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieHordeManager FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        if (!s_Instance)
+            return;
+            
+        SCR_ZombieTimerWheel.CancelTimer(s_Instance.m_iClusterTimer);
+        SCR_ZombieTimerWheel.CancelTimer(s_Instance.m_iSteerTimer);
+        s_Instance = null;
+    }
+    
+    void SCR_ZombieHordeManager()
+    {
+        SCR_ZombieTimerWheel timers = SCR_ZombieTimerWheel.GetInstance();
+        m_iClusterTimer = timers.Schedule(Cluster, CLUSTER_INTERVAL_MS, true);
+        m_iSteerTimer = timers.Schedule(Steer, STEER_INTERVAL_MS, true);
+    }
+    
+    void Register(IEntity zombie)
+    {
+        if (!zombie || m_mSlots.Contains(zombie))
+            return;
+            
+        vector position = zombie.GetOrigin();
+        int slot = m_aZombies.Insert(zombie);
+        m_aControllers.Insert(CharacterControllerComponent.Cast(zombie.FindComponent(CharacterControllerComponent)));
+        m_aCellKeys.Insert(m_Grid.Insert(zombie, position));
+        m_aLeaders.Insert(null);
+        m_aLastPositions.Insert(position);
+        m_aVelocities.Insert(vector.Zero);
+        m_aClusterPasses.Insert(0);
+        m_mSlots.Insert(zombie, slot);
+    }
+    
+    // Followers of a removed leader fall back to their own AI until the next cluster pass
+    void Unregister(IEntity zombie)
+    {
+        int slot;
+        if (!m_mSlots.Find(zombie, slot))
+            return;
+            
+        RemoveSlot(slot);
+    }
+    
+    void Clear()
+    {
+        m_Grid.Clear();
+        m_mSlots.Clear();
+        m_aZombies.Clear();
+        m_aControllers.Clear();
+        m_aCellKeys.Clear();
+        m_aLeaders.Clear();
+        m_aLastPositions.Clear();
+        m_aVelocities.Clear();
+        m_aClusterPasses.Clear();
+        m_iHordeCount = 0;
+        m_iFollowerCount = 0;
+    }
+    
+    protected void RemoveSlot(int slot)
+    {
+        IEntity zombie = m_aZombies[slot];
+        m_Grid.Remove(zombie, m_aCellKeys[slot]);
+        
+        if (zombie)
+        {
+            m_mSlots.Remove(zombie);
+            for (int i = 0; i < m_aLeaders.Count(); i++)
+            {
+                if (m_aLeaders[i] == zombie)
+                    m_aLeaders[i] = null;
+            }
+        }
+        else
+        {
+            // A deleted zombie leaves its key behind as null, find the entry by its slot instead
+            for (int entry = m_mSlots.Count() - 1; entry >= 0; entry--)
+            {
+                if (m_mSlots.GetElement(entry) == slot)
+                {
+                    m_mSlots.RemoveElement(entry);
+                    break;
+                }
+            }
+        }
+        
+        int last = m_aZombies.Count() - 1;
+        if (slot != last)
+        {
+            m_aZombies[slot] = m_aZombies[last];
+            m_aControllers[slot] = m_aControllers[last];
+            m_aCellKeys[slot] = m_aCellKeys[last];
+            m_aLeaders[slot] = m_aLeaders[last];
+            m_aLastPositions[slot] = m_aLastPositions[last];
+            m_aVelocities[slot] = m_aVelocities[last];
+            m_aClusterPasses[slot] = m_aClusterPasses[last];
+            
+            if (m_aZombies[slot])
+                m_mSlots.Set(m_aZombies[slot], slot);
+        }
+        
+        m_aZombies.Remove(last);
+        m_aControllers.Remove(last);
+        m_aCellKeys.Remove(last);
+        m_aLeaders.Remove(last);
+        m_aLastPositions.Remove(last);
+        m_aVelocities.Remove(last);
+        m_aClusterPasses.Remove(last);
+    }
+    
+    // Followers leave wandering, chasing and navigation to their leader
+    bool IsFollower(IEntity zombie)
+    {
+        int slot;
+        if (!m_mSlots.Find(zombie, slot))
+            return false;
+            
+        return m_aLeaders[slot] && m_aLeaders[slot] != zombie;
+    }
+    
+    void CountPathRequest()
+    {
+        if (m_fStatsStartTime < 0)
+            m_fStatsStartTime = GetGame().GetWorld().GetWorldTime();
+            
+        m_iPathRequests++;
+    }
+    
+    float GetPathRequestsPerSecond()
+    {
+        if (m_fStatsStartTime < 0)
+            return 0;
+            
+        float elapsed = (GetGame().GetWorld().GetWorldTime() - m_fStatsStartTime) / 1000;
+        if (elapsed <= 0)
+            return 0;
+            
+        return m_iPathRequests / elapsed;
+    }
+    
+    int GetHordeCount()
+    {
+        return m_iHordeCount;
+    }
+    
+    int GetFollowerCount()
+    {
+        return m_iFollowerCount;
+    }
+    
+    // Zombies per horde including the leader
+    float GetAverageHordeSize()
+    {
+        if (m_iHordeCount == 0)
+            return 0;
+            
+        float members = m_iHordeCount + m_iFollowerCount;
+        return members / m_iHordeCount;
+    }
+    
+    protected void Cluster(Managed context = null)
+    {
+        m_iClusterPass++;
+        CollectPlayerPositions();
+        
+        // Zombies deleted without being unregistered are pruned here
+        for (int slot = m_aZombies.Count() - 1; slot >= 0; slot--)
+        {
+            if (m_aZombies[slot])
+                m_aCellKeys[slot] = m_Grid.Move(m_aZombies[slot], m_aCellKeys[slot], m_aZombies[slot].GetOrigin());
+            else
+                RemoveSlot(slot);
+        }
+        
+        // Leaders of the last pass claim first so hordes stay stable between passes
+        m_iHordeCount = 0;
+        m_iFollowerCount = 0;
+        for (int leaderSlot = 0; leaderSlot < m_aZombies.Count(); leaderSlot++)
+        {
+            if (m_aLeaders[leaderSlot] == m_aZombies[leaderSlot])
+                ClaimHorde(leaderSlot);
+        }
+        
+        for (int freeSlot = 0; freeSlot < m_aZombies.Count(); freeSlot++)
+        {
+            if (m_aClusterPasses[freeSlot] != m_iClusterPass)
+                ClaimHorde(freeSlot);
+        }
+    }
+    
+    // Makes the zombie a leader of the free zombies around it, or leaves it solo
+    protected void ClaimHorde(int slot)
+    {
+        IEntity leader = m_aZombies[slot];
+        if (!leader || m_aClusterPasses[slot] == m_iClusterPass)
+            return;
+            
+        m_aClusterPasses[slot] = m_iClusterPass;
+        m_aLeaders[slot] = null;
+        
+        vector leaderPos = leader.GetOrigin();
+        if (IsEngaged(leaderPos))
+            return;
+            
+        m_aQueryResults.Clear();
+        m_Grid.Query(leaderPos, HORDE_RADIUS, m_aQueryResults);
+        
+        float radiusSq = HORDE_RADIUS * HORDE_RADIUS;
+        int followers = 0;
+        foreach (Managed item : m_aQueryResults)
+        {
+            if (followers >= MAX_HORDE_SIZE - 1)
+                break;
+                
+            IEntity candidate = IEntity.Cast(item);
+            int candidateSlot;
+            if (!candidate || candidate == leader || !m_mSlots.Find(candidate, candidateSlot))
+                continue;
+                
+            if (m_aClusterPasses[candidateSlot] == m_iClusterPass)
+                continue;
+                
+            vector candidatePos = candidate.GetOrigin();
+            if (vector.DistanceSq(leaderPos, candidatePos) > radiusSq || IsEngaged(candidatePos))
+                continue;
+                
+            // A zombie that ran its own AI until now would keep walking its last path under steering
+            IEntity previousLeader = m_aLeaders[candidateSlot];
+            if (!previousLeader || previousLeader == candidate)
+                StopNavigation(candidate, candidatePos);
+                
+            m_aClusterPasses[candidateSlot] = m_iClusterPass;
+            m_aLeaders[candidateSlot] = leader;
+            followers++;
+        }
+        
+        if (followers == 0)
+            return;
+            
+        m_aLeaders[slot] = leader;
+        m_iHordeCount++;
+        m_iFollowerCount += followers;
+    }
+    
+    // A target at the zombie's own position ends whatever path it was following
+    protected void StopNavigation(IEntity zombie, vector position)
+    {
+        AINavigationComponent navComp = AINavigationComponent.Cast(zombie.FindComponent(AINavigationComponent));
+        if (navComp)
+            navComp.SetTarget(position);
+    }
+    
+    protected void Steer(Managed context = null)
+    {
+        float seconds = STEER_INTERVAL_MS / 1000;
+        CollectPlayerPositions();
+        SCR_ZombieMovementLOD movementLOD = SCR_ZombieMovementLOD.GetInstance();
+        
+        // Velocities come from the position change, the character controller does not expose them
+        for (int slot = 0; slot < m_aZombies.Count(); slot++)
+        {
+            if (!m_aZombies[slot])
+                continue;
+                
+            vector position = m_aZombies[slot].GetOrigin();
+            m_aVelocities[slot] = (position - m_aLastPositions[slot]) / seconds;
+            m_aLastPositions[slot] = position;
+        }
+        
+        for (int followerSlot = 0; followerSlot < m_aZombies.Count(); followerSlot++)
+        {
+            IEntity follower = m_aZombies[followerSlot];
+            IEntity leader = m_aLeaders[followerSlot];
+            if (!follower || !leader || leader == follower)
+                continue;
+                
+            // The movement LOD moves mid and far followers like any other zombie
+            if (!movementLOD.IsFullSimulation(follower))
+                continue;
+                
+            vector followerPos = follower.GetOrigin();
+            if (IsEngaged(followerPos))
+            {
+                m_aLeaders[followerSlot] = null;
+                continue;
+            }
+            
+            SteerFollower(followerSlot, followerPos, leader);
+        }
+    }
+    
+    protected void SteerFollower(int slot, vector position, IEntity leader)
+    {
+        vector separation = vector.Zero;
+        vector centroid = vector.Zero;
+        vector heading = vector.Zero;
+        int mates = 0;
+        
+        m_aQueryResults.Clear();
+        m_Grid.Query(position, NEIGHBOR_RADIUS, m_aQueryResults);
+        
+        float neighborSq = NEIGHBOR_RADIUS * NEIGHBOR_RADIUS;
+        float separationSq = SEPARATION_DISTANCE * SEPARATION_DISTANCE;
+        foreach (Managed item : m_aQueryResults)
+        {
+            IEntity neighbor = IEntity.Cast(item);
+            int neighborSlot;
+            if (!neighbor || neighbor == m_aZombies[slot] || !m_mSlots.Find(neighbor, neighborSlot))
+                continue;
+                
+            vector away = position - neighbor.GetOrigin();
+            away[1] = 0;
+            float distanceSq = away.LengthSq();
+            if (distanceSq > neighborSq)
+                continue;
+                
+            // Everyone pushes apart, only horde mates pull together and align
+            if (distanceSq < separationSq && distanceSq > 0)
+                separation += away / distanceSq;
+                
+            if (m_aLeaders[neighborSlot] != leader)
+                continue;
+                
+            centroid += neighbor.GetOrigin();
+            heading += m_aVelocities[neighborSlot];
+            mates++;
+        }
+        
+        vector desired = separation * SEPARATION_WEIGHT;
+        if (mates > 0)
+        {
+            desired += (centroid / mates - position) * COHESION_WEIGHT;
+            desired += (heading / mates) * ALIGNMENT_WEIGHT;
+        }
+        
+        vector toLeader = leader.GetOrigin() - position;
+        if (toLeader.Length() > FOLLOW_DISTANCE)
+            desired += toLeader * FOLLOW_WEIGHT;
+            
+        desired[1] = 0;
+        float speed = Math.Min(desired.Length(), MAX_SPEED);
+        
+        CharacterControllerComponent controller = m_aControllers[slot];
+        if (!controller)
+            return;
+            
+        if (speed < 0.1)
+        {
+            controller.SetMovement(0, vector.Zero);
+            return;
+        }
+        
+        desired.Normalize();
+        controller.SetMovement(speed, m_aZombies[slot].VectorToLocal(desired));
+    }
+    
+    protected bool IsEngaged(vector position)
+    {
+        float engageSq = ENGAGE_DISTANCE * ENGAGE_DISTANCE;
+        foreach (vector playerPosition : m_aPlayerPositions)
+        {
+            if (vector.DistanceSq(position, playerPosition) < engageSq)
+                return true;
+        }
+        
+        return false;
+    }
+    
+    protected void CollectPlayerPositions()
+    {
+        m_aPlayerIds.Clear();
+        m_aPlayerPositions.Clear();
+        
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        playerManager.GetPlayers(m_aPlayerIds);
+        foreach (int playerId : m_aPlayerIds)
+        {
+            IEntity playerEntity = playerManager.GetPlayerControlledEntity(playerId);
+            if (playerEntity)
+                m_aPlayerPositions.Insert(playerEntity.GetOrigin());
+        }
+    }
+}
@@ -0,0 +1,188 @@
+// Wire format of the far horde summary sent to each client. The first int is the origin cell,
+// every following int one populated cell relative to it: offsets, zombie count and heading, a byte
+// each.
+class SCR_ZombieHordeSummary
+{
+    // Same cells as the virtual population grid
+    static const float CELL_SIZE = 100;
+    static const int ORIGIN_OFFSET = 32768;
+    static const int CELL_OFFSET = 128;
+    static const int MAX_COUNT = 255;
+    
+    static int GetCellCoord(float worldCoord)
+    {
+        return Math.Floor(worldCoord / CELL_SIZE);
+    }
+    
+    static int PackOrigin(int cellX, int cellZ)
+    {
+        return (((cellX + ORIGIN_OFFSET) & 0xFFFF) << 16) | ((cellZ + ORIGIN_OFFSET) & 0xFFFF);
+    }
+    
+    static int UnpackOriginX(int packed)
+    {
+        return ((packed >> 16) & 0xFFFF) - ORIGIN_OFFSET;
+    }
+    
+    static int UnpackOriginZ(int packed)
+    {
+        return (packed & 0xFFFF) - ORIGIN_OFFSET;
+    }
+    
+    static int PackCell(int offsetX, int offsetZ, int count, int heading)
+    {
+        return (((offsetX + CELL_OFFSET) & 0xFF) << 24) | (((offsetZ + CELL_OFFSET) & 0xFF) << 16) | (Math.Min(count, MAX_COUNT) << 8) | (heading & 0xFF);
+    }
+    
+    static int UnpackOffsetX(int packed)
+    {
+        return ((packed >> 24) & 0xFF) - CELL_OFFSET;
+    }
+    
+    static int UnpackOffsetZ(int packed)
+    {
+        return ((packed >> 16) & 0xFF) - CELL_OFFSET;
+    }
+    
+    static int UnpackCount(int packed)
+    {
+        return (packed >> 8) & 0xFF;
+    }
+    
+    // 256 steps over the full circle, returned in degrees
+    static float UnpackHeading(int packed)
+    {
+        return (packed & 0xFF) * 360.0 / 256;
+    }
+    
+    // Virtual zombies have no heading, a per cell hash keeps the crowd facing the same way between updates
+    static int GetCellHeading(int cellX, int cellZ)
+    {
+        return ((cellX * 73856093) ^ (cellZ * 19349663)) & 0xFF;
+    }
+    
+    static int Hash(notnull array<int> packed)
+    {
+        int hash = packed.Count();
+        foreach (int value : packed)
+        {
+            hash = hash * 31 + value;
+        }
+        
+        return hash;
+    }
+}
+
+// Client only. Renders the far horde summary as local impostor entities beyond interaction range;
+// they are spawned locally, never simulated and never exist on the server. Entities are pooled and
+// moved between summaries, placement inside a cell is hashed so the crowd does not reshuffle.
+class SCR_ZombieImpostorCrowd
+{
+    static const int MAX_IMPOSTORS = 64;
+    static const int MAX_PER_CELL = 6;
+    
+    protected ResourceName m_Prefab;
+    protected ref array<IEntity> m_aImpostors = new array<IEntity>();
+    protected int m_iVisibleCount;
+    
+    void SCR_ZombieImpostorCrowd(ResourceName prefab)
+    {
+        m_Prefab = prefab;
+    }
+    
+    int GetVisibleCount()
+    {
+        return m_iVisibleCount;
+    }
+    
+    void Apply(notnull array<int> packed)
+    {
+        if (m_Prefab.IsEmpty() || packed.IsEmpty())
+            return;
+            
+        int originX = SCR_ZombieHordeSummary.UnpackOriginX(packed[0]);
+        int originZ = SCR_ZombieHordeSummary.UnpackOriginZ(packed[0]);
+        BaseWorld world = GetGame().GetWorld();
+        
+        int used = 0;
+        for (int i = 1; i < packed.Count() && used < MAX_IMPOSTORS; i++)
+        {
+            int cellX = originX + SCR_ZombieHordeSummary.UnpackOffsetX(packed[i]);
+            int cellZ = originZ + SCR_ZombieHordeSummary.UnpackOffsetZ(packed[i]);
+            int count = Math.Min(SCR_ZombieHordeSummary.UnpackCount(packed[i]), MAX_PER_CELL);
+            float heading = SCR_ZombieHordeSummary.UnpackHeading(packed[i]);
+            
+            for (int member = 0; member < count && used < MAX_IMPOSTORS; member++)
+            {
+                int memberHash = (cellX * 73856093) ^ (cellZ * 19349663) ^ (member * 83492791);
+                float offsetX = (memberHash & 0xFF) / 256.0 * SCR_ZombieHordeSummary.CELL_SIZE;
+                float offsetZ = ((memberHash >> 8) & 0xFF) / 256.0 * SCR_ZombieHordeSummary.CELL_SIZE;
+                
+                vector position = Vector(cellX * SCR_ZombieHordeSummary.CELL_SIZE + offsetX, 0, cellZ * SCR_ZombieHordeSummary.CELL_SIZE + offsetZ);
+                position[1] = world.GetSurfaceY(position[0], position[2]);
+                
+                vector transform[4];
+                Math3D.AnglesToMatrix(Vector(heading + ((memberHash >> 16) & 0x1F) - 16, 0, 0), transform);
+                transform[3] = position;
+                
+                if (!PlaceImpostor(used, transform))
+                    return;
+                    
+                used++;
+            }
+        }
+        
+        // Leftovers stay pooled but hidden
+        for (int hidden = used; hidden < m_aImpostors.Count(); hidden++)
+        {
+            if (m_aImpostors[hidden])
+                m_aImpostors[hidden].ClearFlags(EntityFlags.VISIBLE, false);
+        }
+        
+        m_iVisibleCount = used;
+    }
+    
+    void Clear()
+    {
+        foreach (IEntity impostor : m_aImpostors)
+        {
+            if (impostor)
+                SCR_EntityHelper.DeleteEntityAndChildren(impostor);
+        }
+        
+        m_aImpostors.Clear();
+        m_iVisibleCount = 0;
+    }
+    
+    protected bool PlaceImpostor(int index, vector transform[4])
+    {
+        if (index < m_aImpostors.Count() && m_aImpostors[index])
+        {
+            m_aImpostors[index].SetWorldTransform(transform);
+            m_aImpostors[index].SetFlags(EntityFlags.VISIBLE, false);
+            return true;
+        }
+        
+        Resource resource = Resource.Load(m_Prefab);
+        if (!resource)
+            return false;
+            
+        EntitySpawnParams params = new EntitySpawnParams();
+        params.TransformMode = ETransformMode.WORLD;
+        for (int row = 0; row < 4; row++)
+        {
+            params.Transform[row] = transform[row];
+        }
+        
+        IEntity impostor = GetGame().SpawnEntityPrefabLocal(resource, GetGame().GetWorld(), params);
+        if (!impostor)
+            return false;
+            
+        if (index < m_aImpostors.Count())
+            m_aImpostors[index] = impostor;
+        else
+            m_aImpostors.Insert(impostor);
+            
+        return true;
+    }
+}
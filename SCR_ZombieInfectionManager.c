@@ -0,0 +1,250 @@
+// Server-side owner of every player's infection. State lives in one contiguous table of parallel
+// arrays, progressed in a single batched pass; players are looked up through an entity to slot map.
+class SCR_ZombieInfectionManager : ScriptComponent
+{
+    [Attribute("5.0", UIWidgets.Auto, "Amount of infection from zombie attack")]
+    protected float m_fInfectionPerAttack;
+    
+    [Attribute("0.1", UIWidgets.Auto, "Rate at which infection progresses per second")]
+    protected float m_fInfectionProgressRate;
+    
+    [Attribute("1.0", UIWidgets.Auto, "Interval in seconds between batched infection updates")]
+    protected float m_fUpdateInterval;
+    
+    [Attribute("20.0", UIWidgets.Auto, "Infection level at which mild effects begin")]
+    protected float m_fMildEffectsThreshold;
+    
+    [Attribute("50.0", UIWidgets.Auto, "Infection level at which moderate effects begin")]
+    protected float m_fModerateEffectsThreshold;
+    
+    [Attribute("80.0", UIWidgets.Auto, "Infection level at which severe effects begin")]
+    protected float m_fSevereEffectsThreshold;
+    
+    [Attribute("100.0", UIWidgets.Auto, "Infection level at which death occurs")]
+    protected float m_fDeathThreshold;
+    
+    protected static SCR_ZombieInfectionManager s_Instance;
+    
+    // Slot per registered player, removal swaps the last slot in to keep the table dense
+    protected ref array<IEntity> m_aPlayers = new array<IEntity>();
+    protected ref array<float> m_aLevels = new array<float>();
+    protected ref array<bool> m_aInfected = new array<bool>();
+    protected ref array<int> m_aStages = new array<int>();
+    protected ref array<SCR_ZombiePlayerStateComponent> m_aPlayerStates = new array<SCR_ZombiePlayerStateComponent>();
+    protected ref map<IEntity, int> m_mSlots = new map<IEntity, int>();
+    
+    protected int m_iUpdateTimer;
+    
+    static SCR_ZombieInfectionManager GetInstance()
+    {
+        return s_Instance;
+    }
+    
+    override void OnPostInit(IEntity owner)
+    {
+        super.OnPostInit(owner);
+        
+        s_Instance = this;
+        m_iUpdateTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(UpdateInfections, m_fUpdateInterval * 1000, true);
+    }
+    
+    override void OnDelete(IEntity owner)
+    {
+        SCR_ZombieTimerWheel.CancelTimer(m_iUpdateTimer);
+        
+        if (s_Instance == this)
+            s_Instance = null;
+            
+        super.OnDelete(owner);
+    }
+    
+    void RegisterPlayer(IEntity player)
+    {
+        if (!player || m_mSlots.Contains(player))
+            return;
+            
+        int slot = m_aPlayers.Insert(player);
+        m_aLevels.Insert(0);
+        m_aInfected.Insert(false);
+        m_aStages.Insert(-1);
+        m_aPlayerStates.Insert(SCR_ZombiePlayerStateComponent.Cast(player.FindComponent(SCR_ZombiePlayerStateComponent)));
+        m_mSlots.Insert(player, slot);
+    }
+    
+    void UnregisterPlayer(IEntity player)
+    {
+        int slot;
+        if (m_mSlots.Find(player, slot))
+            RemoveSlot(slot);
+    }
+    
+    // Returns false when the player is not tracked, so callers can fall back to other effects
+    bool AddInfection(IEntity player, float amount)
+    {
+        int slot;
+        if (!m_mSlots.Find(player, slot))
+            return false;
+            
+        SetLevel(slot, m_aLevels[slot] + amount);
+        return true;
+    }
+    
+    bool ApplyAttackInfection(IEntity player)
+    {
+        return AddInfection(player, m_fInfectionPerAttack);
+    }
+    
+    void SetInfectionLevel(IEntity player, float level)
+    {
+        int slot;
+        if (m_mSlots.Find(player, slot))
+            SetLevel(slot, level);
+    }
+    
+    void Cure(IEntity player)
+    {
+        int slot;
+        if (m_mSlots.Find(player, slot))
+            SetLevel(slot, 0);
+    }
+    
+    float GetInfectionLevel(IEntity player)
+    {
+        int slot;
+        if (!m_mSlots.Find(player, slot))
+            return 0;
+            
+        return m_aLevels[slot];
+    }
+    
+    bool IsInfected(IEntity player)
+    {
+        int slot;
+        return m_mSlots.Find(player, slot) && m_aInfected[slot];
+    }
+    
+    int GetTrackedPlayerCount()
+    {
+        return m_aPlayers.Count();
+    }
+    
+    protected void UpdateInfections(Managed context = null)
+    {
+        float progress = m_fInfectionProgressRate * m_fUpdateInterval;
+        
+        for (int slot = m_aPlayers.Count() - 1; slot >= 0; slot--)
+        {
+            IEntity player = m_aPlayers[slot];
+            if (!player)
+            {
+                RemoveSlot(slot);
+                continue;
+            }
+            
+            if (!m_aInfected[slot] || m_aLevels[slot] >= m_fDeathThreshold)
+                continue;
+                
+            SetLevel(slot, m_aLevels[slot] + progress);
+            
+            // Check for death threshold
+            if (m_aLevels[slot] >= m_fDeathThreshold)
+                KillFromInfection(player);
+        }
+    }
+    
+    protected void SetLevel(int slot, float level)
+    {
+        level = Math.Clamp(level, 0, m_fDeathThreshold);
+        m_aLevels[slot] = level;
+        m_aInfected[slot] = level > 0;
+        
+        SCR_ZombiePlayerStateComponent playerState = m_aPlayerStates[slot];
+        if (playerState)
+            playerState.SetInfection(level);
+            
+        UpdateStage(slot);
+    }
+    
+    // Stage effects carry the stamina penalty and the client's visuals, only touched on change
+    protected void UpdateStage(int slot)
+    {
+        float level = m_aLevels[slot];
+        int stage = -1;
+        
+        if (level > m_fSevereEffectsThreshold)
+            stage = SCR_EZombieStatusEffect.INFECTION_SEVERE;
+        else if (level > m_fModerateEffectsThreshold)
+            stage = SCR_EZombieStatusEffect.INFECTION_MODERATE;
+        else if (level > m_fMildEffectsThreshold)
+            stage = SCR_EZombieStatusEffect.INFECTION_MILD;
+            
+        int previousStage = m_aStages[slot];
+        if (stage == previousStage)
+            return;
+            
+        m_aStages[slot] = stage;
+        
+        SCR_ZombieStatusEffectManager effects = SCR_ZombieStatusEffectManager.GetInstance();
+        IEntity player = m_aPlayers[slot];
+        
+        if (previousStage != -1)
+            effects.RemoveEffect(player, previousStage);
+            
+        if (stage != -1)
+            effects.AddEffect(player, stage);
+    }
+    
+    protected void RemoveSlot(int slot)
+    {
+        IEntity player = m_aPlayers[slot];
+        if (player)
+        {
+            m_mSlots.Remove(player);
+        }
+        else
+        {
+            // A deleted player leaves its key behind as null, find the entry by its slot instead
+            for (int entry = m_mSlots.Count() - 1; entry >= 0; entry--)
+            {
+                if (m_mSlots.GetElement(entry) == slot)
+                {
+                    m_mSlots.RemoveElement(entry);
+                    break;
+                }
+            }
+        }
+        
+        int last = m_aPlayers.Count() - 1;
+        if (slot != last)
+        {
+            m_aPlayers[slot] = m_aPlayers[last];
+            m_aLevels[slot] = m_aLevels[last];
+            m_aInfected[slot] = m_aInfected[last];
+            m_aStages[slot] = m_aStages[last];
+            m_aPlayerStates[slot] = m_aPlayerStates[last];
+            
+            if (m_aPlayers[slot])
+                m_mSlots.Set(m_aPlayers[slot], slot);
+        }
+        
+        m_aPlayers.Remove(last);
+        m_aLevels.Remove(last);
+        m_aInfected.Remove(last);
+        m_aStages.Remove(last);
+        m_aPlayerStates.Remove(last);
+    }
+    
+    protected void KillFromInfection(IEntity player)
+    {
+        // Kill character when infection reaches lethal level
+        DamageManagerComponent dmgMgr = DamageManagerComponent.Cast(player.FindComponent(DamageManagerComponent));
+        if (dmgMgr)
+        {
+            DamageParams params = new DamageParams();
+            params.Damage = 100.0;
+            params.DamageType = EDamageType.BIOLOGICAL;
+            
+            dmgMgr.InflictDamage(params);
+        }
+    }
+}
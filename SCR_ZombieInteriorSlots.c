@@ -0,0 +1,335 @@
+[BaseContainerProps()]
+class SCR_ZombieBuildingSlots
+{
+    [Attribute("", UIWidgets.ResourceNamePicker, "Building prefab", "et")]
+    ResourceName m_Prefab;
+    
+    [Attribute("", UIWidgets.Auto, "Interior spawn positions in the building's local space, baked when empty and baking is enabled")]
+    ref array<vector> m_aSlots;
+}
+
+[BaseContainerProps(configRoot: true)]
+class SCR_ZombieInteriorSlotConfig
+{
+    [Attribute("", UIWidgets.Object, "Buildings zombies can spawn inside")]
+    ref array<ref SCR_ZombieBuildingSlots> m_aBuildings;
+}
+
+// One placed building with the world positions of its prefab's slots
+class SCR_ZombieBuildingInstance
+{
+    IEntity m_Building;
+    ref array<vector> m_aSlots = new array<vector>();
+}
+
+// Interior spawn slots. Slots are baked once per building prefab in local space, from the config
+// or by bake-time traces, and instanced per placed building when the map is indexed. Placed
+// buildings are bucketed in a spatial grid, so picking an interior spawn near a player is a cell
+// lookup and needs no runtime traces; the terrain check would reject these points anyway.
+class SCR_ZombieInteriorSlots
+{
+    static const float GRID_CELL_SIZE = 100;
+    
+    // World indexing queries small tiles, as many per frame as fit the entity visit budget; a forest
+    // tile alone can hold thousands of entities, so tiles are kept small
+    static const float INDEX_TILE_SIZE = 200;
+    static const int INDEX_VISIT_BUDGET = 2000;
+    
+    // Bake-time trace grid over the building bounds
+    static const float BAKE_SPACING = 2;
+    static const float BAKE_HEADROOM = 1.9;
+    static const int MAX_SLOTS_PER_PREFAB = 16;
+    
+    protected static ref SCR_ZombieInteriorSlots s_Instance;
+    
+    // Local slots per prefab, shared by every placed instance
+    protected ref map<ResourceName, ref array<vector>> m_mPrefabSlots = new map<ResourceName, ref array<vector>>();
+    protected bool m_bBakeMissing;
+    
+    protected ref SCR_ZombieSpatialGrid m_Grid = new SCR_ZombieSpatialGrid(GRID_CELL_SIZE);
+    protected ref array<ref SCR_ZombieBuildingInstance> m_aInstances = new array<ref SCR_ZombieBuildingInstance>();
+    protected ref array<Managed> m_aQueryResults = new array<Managed>();
+    
+    // Indexing state
+    protected int m_iIndexTimer;
+    protected vector m_vIndexMins;
+    protected vector m_vIndexMaxs;
+    protected int m_iIndexTile;
+    protected int m_iIndexTilesX;
+    protected int m_iIndexTileCount;
+    protected int m_iIndexVisited;
+    
+    protected int m_iSlotCount;
+    protected int m_iBakedPrefabs;
+    protected int m_iSpawnCount;
+    
+    static SCR_ZombieInteriorSlots GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieInteriorSlots();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieInteriorSlots FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        if (!s_Instance)
+            return;
+            
+        SCR_ZombieTimerWheel.CancelTimer(s_Instance.m_iIndexTimer);
+        s_Instance = null;
+    }
+    
+    // With bakeMissing, listed prefabs without slots are baked by traces the first time one is
+    // indexed and the result is printed for the config
+    void Load(ResourceName configPath, bool bakeMissing)
+    {
+        m_mPrefabSlots.Clear();
+        m_bBakeMissing = bakeMissing;
+        if (configPath.IsEmpty())
+            return;
+            
+        Resource resource = Resource.Load(configPath);
+        if (!resource || !resource.IsValid())
+        {
+            Print(string.Format("[Zombies] Interior slot config %1 could not be loaded", configPath), LogLevel.ERROR);
+            return;
+        }
+        
+        SCR_ZombieInteriorSlotConfig config = SCR_ZombieInteriorSlotConfig.Cast(BaseContainerTools.CreateInstanceFromContainer(resource.GetResource().ToBaseContainer()));
+        if (!config || !config.m_aBuildings)
+            return;
+            
+        foreach (SCR_ZombieBuildingSlots building : config.m_aBuildings)
+        {
+            if (!building || building.m_Prefab.IsEmpty())
+                continue;
+                
+            array<vector> slots = new array<vector>();
+            if (building.m_aSlots)
+                slots.Copy(building.m_aSlots);
+                
+            m_mPrefabSlots.Set(building.m_Prefab, slots);
+        }
+    }
+    
+    // Indexes the placed buildings of known prefabs across the world in background slices
+    void StartIndexing()
+    {
+        Clear();
+        if (m_mPrefabSlots.IsEmpty())
+            return;
+            
+        GetGame().GetWorld().GetBoundBox(m_vIndexMins, m_vIndexMaxs);
+        m_iIndexTilesX = Math.Ceil((m_vIndexMaxs[0] - m_vIndexMins[0]) / INDEX_TILE_SIZE);
+        int tilesZ = Math.Ceil((m_vIndexMaxs[2] - m_vIndexMins[2]) / INDEX_TILE_SIZE);
+        m_iIndexTileCount = m_iIndexTilesX * tilesZ;
+        m_iIndexTile = 0;
+        
+        SCR_ZombieTimerWheel timers = SCR_ZombieTimerWheel.GetInstance();
+        timers.Cancel(m_iIndexTimer);
+        m_iIndexTimer = timers.Schedule(IndexTile, 0);
+    }
+    
+    bool IsIndexing()
+    {
+        return SCR_ZombieTimerWheel.GetInstance().IsScheduled(m_iIndexTimer);
+    }
+    
+    void Clear()
+    {
+        m_Grid.Clear();
+        m_aInstances.Clear();
+        m_iSlotCount = 0;
+    }
+    
+    int GetBuildingCount()
+    {
+        return m_aInstances.Count();
+    }
+    
+    int GetSlotCount()
+    {
+        return m_iSlotCount;
+    }
+    
+    int GetBakedPrefabCount()
+    {
+        return m_iBakedPrefabs;
+    }
+    
+    int GetSpawnCount()
+    {
+        return m_iSpawnCount;
+    }
+    
+    // Random slot of a random indexed building between the two distances, false when none is near
+    bool FindSlot(vector center, float minDistance, float maxDistance, out vector position)
+    {
+        m_aQueryResults.Clear();
+        if (m_Grid.Query(center, maxDistance, m_aQueryResults) == 0)
+            return false;
+            
+        // A few random picks are enough, the caller falls back to an outdoor position
+        for (int attempt = 0; attempt < 4; attempt++)
+        {
+            SCR_ZombieBuildingInstance instance = SCR_ZombieBuildingInstance.Cast(m_aQueryResults.GetRandomElement());
+            if (!instance || !instance.m_Building)
+                continue;
+                
+            vector slot = instance.m_aSlots.GetRandomElement();
+            float distanceSq = vector.DistanceSqXZ(center, slot);
+            if (distanceSq < minDistance * minDistance || distanceSq > maxDistance * maxDistance)
+                continue;
+                
+            position = slot;
+            m_iSpawnCount++;
+            return true;
+        }
+        
+        return false;
+    }
+    
+    protected void IndexTile(Managed context = null)
+    {
+        BaseWorld world = GetGame().GetWorld();
+        m_iIndexVisited = 0;
+        
+        // A tile is never split, the budget only decides whether the next one still fits this frame
+        while (m_iIndexTile < m_iIndexTileCount && m_iIndexVisited < INDEX_VISIT_BUDGET)
+        {
+            int tileX = m_iIndexTile % m_iIndexTilesX;
+            int tileZ = m_iIndexTile / m_iIndexTilesX;
+            vector mins = Vector(m_vIndexMins[0] + tileX * INDEX_TILE_SIZE, m_vIndexMins[1], m_vIndexMins[2] + tileZ * INDEX_TILE_SIZE);
+            vector maxs = Vector(mins[0] + INDEX_TILE_SIZE, m_vIndexMaxs[1], mins[2] + INDEX_TILE_SIZE);
+            world.QueryEntitiesByAABB(mins, maxs, AddBuilding, IsKnownBuilding);
+            m_iIndexTile++;
+        }
+        
+        if (m_iIndexTile < m_iIndexTileCount)
+        {
+            m_iIndexTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(IndexTile, 0);
+            return;
+        }
+        
+        Print(string.Format("[Zombies] Indexed %1 interior spawn slots in %2 buildings", m_iSlotCount, m_aInstances.Count()), LogLevel.NORMAL);
+    }
+    
+    protected bool IsKnownBuilding(IEntity entity)
+    {
+        m_iIndexVisited++;
+        return m_mPrefabSlots.Contains(GetPrefabName(entity));
+    }
+    
+    // Buildings straddling a tile border are reported by both tiles, only the tile holding the origin keeps them
+    protected bool AddBuilding(IEntity entity)
+    {
+        vector origin = entity.GetOrigin();
+        int tileX = Math.Floor((origin[0] - m_vIndexMins[0]) / INDEX_TILE_SIZE);
+        int tileZ = Math.Floor((origin[2] - m_vIndexMins[2]) / INDEX_TILE_SIZE);
+        if (tileZ * m_iIndexTilesX + tileX != m_iIndexTile)
+            return true;
+            
+        ResourceName prefab = GetPrefabName(entity);
+        array<vector> localSlots = m_mPrefabSlots.Get(prefab);
+        if (localSlots.IsEmpty() && m_bBakeMissing)
+        {
+            BakeBuilding(entity, localSlots);
+            m_iBakedPrefabs++;
+            
+            string baked;
+            foreach (vector bakedSlot : localSlots)
+            {
+                baked += string.Format("%1 %2 %3 ", bakedSlot[0], bakedSlot[1], bakedSlot[2]);
+            }
+            
+            Print(string.Format("[Zombies] Baked %1 interior slots for %2: %3", localSlots.Count(), prefab, baked), LogLevel.NORMAL);
+            
+            // A prefab that bakes empty is not baked again for every placement
+            if (localSlots.IsEmpty())
+            {
+                m_mPrefabSlots.Remove(prefab);
+                return true;
+            }
+        }
+        
+        if (localSlots.IsEmpty())
+            return true;
+            
+        SCR_ZombieBuildingInstance instance = new SCR_ZombieBuildingInstance();
+        instance.m_Building = entity;
+        foreach (vector localSlot : localSlots)
+        {
+            instance.m_aSlots.Insert(entity.CoordToParent(localSlot));
+        }
+        
+        m_aInstances.Insert(instance);
+        m_Grid.Insert(instance, origin);
+        m_iSlotCount += localSlots.Count();
+        return true;
+    }
+    
+    protected ResourceName GetPrefabName(IEntity entity)
+    {
+        EntityPrefabData prefabData = entity.GetPrefabData();
+        if (!prefabData)
+            return ResourceName.Empty;
+            
+        return prefabData.GetPrefabName();
+    }
+    
+    // Bake-time only. Columns over the building bounds are traced downward floor by floor; the
+    // first surface is the roof, every walkable surface below it with headroom is an interior slot.
+    static int BakeBuilding(IEntity building, notnull array<vector> outLocalSlots)
+    {
+        BaseWorld world = building.GetWorld();
+        vector mins, maxs;
+        building.GetBounds(mins, maxs);
+        
+        array<vector> candidates = new array<vector>();
+        for (float x = mins[0] + BAKE_SPACING * 0.5; x < maxs[0]; x += BAKE_SPACING)
+        {
+            for (float z = mins[2] + BAKE_SPACING * 0.5; z < maxs[2]; z += BAKE_SPACING)
+            {
+                float top = maxs[1] + 1;
+                bool roofed = false;
+                while (top > mins[1])
+                {
+                    TraceParam trace = new TraceParam();
+                    trace.Start = building.CoordToParent(Vector(x, top, z));
+                    trace.End = building.CoordToParent(Vector(x, mins[1] - 1, z));
+                    trace.LayerMask = EPhysicsLayerMask.BUILDINGS | EPhysicsLayerMask.TERRAIN;
+                    trace.Flags = TraceFlags.WORLD | TraceFlags.ENTS;
+                    
+                    float fraction;
+                    vector hitPos, hitNormal;
+                    if (!world.TraceMove(trace, fraction, hitPos, hitNormal))
+                        break;
+                        
+                    vector localHit = building.CoordToLocal(hitPos);
+                    if (roofed && hitNormal[1] >= 0.7 && top - localHit[1] >= BAKE_HEADROOM)
+                        candidates.Insert(localHit + Vector(0, 0.1, 0));
+                        
+                    roofed = true;
+                    top = localHit[1] - 0.3;
+                }
+            }
+        }
+        
+        // Thin evenly so large buildings do not dominate the slot count
+        float candidateCount = candidates.Count();
+        float step = Math.Max(candidateCount / MAX_SLOTS_PER_PREFAB, 1);
+        for (float index = 0; index < candidates.Count() && outLocalSlots.Count() < MAX_SLOTS_PER_PREFAB; index += step)
+        {
+            outLocalSlots.Insert(candidates[Math.Floor(index)]);
+        }
+        
+        return outLocalSlots.Count();
+    }
+}
@@ -1,40 +1,221 @@
+// The rolled item is kept as a virtual record; an entity only exists while a player is nearby,
+// see SCR_ZombieLootSpawnerRegistry.UpdateStreaming.
 class SCR_ZombieItemSpawnerComponent : ScriptComponent
 {
-    [Attribute("", UIWidgets.Auto, "Array of item prefabs that can spawn here")]
-    protected ref array<ResourceName> m_aPossibleItems;
+    [Attribute("", UIWidgets.EditBox, "ID of the shared loot table items are drawn from")]
+    protected string m_sLootTable;
     
     [Attribute("0.5", UIWidgets.Auto, "Chance that an item will spawn (0-1)")]
     protected float m_fSpawnChance;
     
+    [Attribute("0", UIWidgets.ComboBox, "Loot category used for respawn cycles", "", ParamEnumArray.FromEnum(SCR_EZombieLootCategory))]
+    protected SCR_EZombieLootCategory m_eCategory;
+    
+    protected int m_iLootTable = -1;
+    protected bool m_bLootTableResolved;
+    protected bool m_bInitialRollDone;
+    protected ResourceName m_RolledItem;
     protected IEntity m_CurrentSpawnedItem;
+    protected bool m_bMaterialized;
+    protected int m_iStreamPass;
+    protected int m_iRegistryIndex = -1;
+    protected bool m_bQueuedForRespawn;
+    protected float m_fEmptiedTime = -1;
     
     override void OnPostInit(IEntity owner)
     {
         super.OnPostInit(owner);
         
-        // Initial spawn with chance
+        SCR_ZombieLootSpawnerRegistry.GetInstance().Register(this);
+        
+        // Otherwise the table manager rolls every registered spawner once it has loaded
+        if (SCR_ZombieLootTableManager.GetInstance().IsLoaded())
+            RollInitialItem();
+    }
+    
+    override void OnDelete(IEntity owner)
+    {
+        SCR_ZombieLootSpawnerRegistry registry = SCR_ZombieLootSpawnerRegistry.FindInstance();
+        if (registry)
+            registry.Unregister(this);
+            
+        super.OnDelete(owner);
+    }
+    
+    SCR_EZombieLootCategory GetCategory()
+    {
+        return m_eCategory;
+    }
+    
+    int GetRegistryIndex()
+    {
+        return m_iRegistryIndex;
+    }
+    
+    void SetRegistryIndex(int index)
+    {
+        m_iRegistryIndex = index;
+    }
+    
+    int GetStreamPass()
+    {
+        return m_iStreamPass;
+    }
+    
+    void SetStreamPass(int pass)
+    {
+        m_iStreamPass = pass;
+    }
+    
+    bool IsQueuedForRespawn()
+    {
+        return m_bQueuedForRespawn;
+    }
+    
+    void SetQueuedForRespawn(bool queued, float emptiedTime = -1)
+    {
+        m_bQueuedForRespawn = queued;
+        m_fEmptiedTime = emptiedTime;
+    }
+    
+    float GetEmptiedTime()
+    {
+        return m_fEmptiedTime;
+    }
+    
+    ResourceName GetRolledItem()
+    {
+        return m_RolledItem;
+    }
+    
+    // Replaces whatever the initial roll produced with the state from a persistence snapshot
+    void RestoreState(ResourceName rolledItem, float emptiedAgeMs)
+    {
+        m_bInitialRollDone = true;
+        
+        // The initial roll may already have queued an empty spawner at the current time
+        SCR_ZombieLootSpawnerRegistry registry = SCR_ZombieLootSpawnerRegistry.GetInstance();
+        if (m_bQueuedForRespawn)
+            registry.CancelRespawn(this);
+            
+        if (m_CurrentSpawnedItem)
+        {
+            SCR_EntityHelper.DeleteEntityAndChildren(m_CurrentSpawnedItem);
+            m_CurrentSpawnedItem = null;
+        }
+        
+        m_RolledItem = rolledItem;
+        if (IsEmpty())
+        {
+            registry.QueueRespawn(this, emptiedAgeMs);
+            return;
+        }
+        
+        if (m_bMaterialized)
+            SpawnEntity();
+    }
+    
+    void RollInitialItem()
+    {
+        if (m_bInitialRollDone)
+            return;
+            
+        m_bInitialRollDone = true;
+        
+        // Initial roll with chance, the entity follows once a player comes close
         if (Math.RandomFloat01() <= m_fSpawnChance)
         {
             SpawnItem();
         }
+        
+        // Spawners that rolled nothing wait for the regular respawn delay
+        if (IsEmpty())
+            SCR_ZombieLootSpawnerRegistry.GetInstance().QueueRespawn(this);
+    }
+    
+    // Spawners never move, so the table including region overrides is resolved once. A spawner with
+    // an unknown table is reported once and never spawns or queues.
+    bool HasLootTable()
+    {
+        if (m_bLootTableResolved)
+            return m_iLootTable != -1;
+            
+        SCR_ZombieLootTableManager lootTables = SCR_ZombieLootTableManager.GetInstance();
+        if (!lootTables.IsLoaded())
+            return false;
+            
+        m_bLootTableResolved = true;
+        m_iLootTable = lootTables.ResolveTable(m_sLootTable, GetOwner().GetOrigin());
+        if (m_iLootTable == -1)
+            Print(string.Format("[Zombies] Item spawner at %1 uses unknown loot table '%2', it is disabled", GetOwner().GetOrigin(), m_sLootTable), LogLevel.ERROR);
+            
+        return m_iLootTable != -1;
     }
     
     bool IsEmpty()
     {
-        return !m_CurrentSpawnedItem;
+        return m_RolledItem.IsEmpty();
+    }
+    
+    bool IsMaterialized()
+    {
+        return m_bMaterialized;
     }
     
+    // Rolls the virtual item, the entity is created right away only while a player is nearby
     void SpawnItem()
     {
-        if (!IsEmpty() || m_aPossibleItems.IsEmpty())
+        if (!IsEmpty() || !HasLootTable())
             return;
             
-        // Pick random item from possible items
-        ResourceName selectedItem = m_aPossibleItems.GetRandomElement();
-        Resource itemRes = Resource.Load(selectedItem);
-        if (!itemRes)
+        m_RolledItem = SCR_ZombieLootTableManager.GetInstance().Draw(m_iLootTable);
+        
+        if (!IsEmpty() && m_bMaterialized)
+            SpawnEntity();
+    }
+    
+    void Materialize()
+    {
+        if (m_bMaterialized)
+            return;
+            
+        m_bMaterialized = true;
+        if (!IsEmpty())
+            SpawnEntity();
+    }
+    
+    // Removes the entity but keeps the roll, so the same item is there when a player returns
+    void Dematerialize()
+    {
+        if (!m_bMaterialized)
             return;
             
+        m_bMaterialized = false;
+        if (m_CurrentSpawnedItem)
+        {
+            SCR_EntityHelper.DeleteEntityAndChildren(m_CurrentSpawnedItem);
+            m_CurrentSpawnedItem = null;
+        }
+        else if (!IsEmpty())
+        {
+            // The item vanished without a pickup event, e.g. it was destroyed
+            ClearRoll();
+        }
+    }
+    
+    protected void SpawnEntity()
+    {
+        if (m_CurrentSpawnedItem)
+            return;
+            
+        Resource itemRes = Resource.Load(m_RolledItem);
+        if (!itemRes)
+        {
+            // Unusable roll, drop it so the respawn queue picks another one
+            ClearRoll();
+            return;
+        }
+        
         // Set up spawn parameters
         EntitySpawnParams params = new EntitySpawnParams();
         params.TransformMode = ETransformMode.WORLD;
@@ -56,11 +237,24 @@ class SCR_ZombieItemSpawnerComponent : ScriptComponent
         }
     }
     
+    protected void ClearRoll()
+    {
+        m_RolledItem = ResourceName.Empty;
+        m_CurrentSpawnedItem = null;
+        SCR_ZombieLootSpawnerRegistry.GetInstance().QueueRespawn(this);
+    }
+    
     protected void OnItemPickedUp(IEntity item, IEntity user)
     {
-        if (item == m_CurrentSpawnedItem)
-        {
-            m_CurrentSpawnedItem = null;
-        }
+        if (item != m_CurrentSpawnedItem)
+            return;
+            
+        ClearRoll();
+        
+        // Once taken the item is the player's, only once it lies on the ground again does its age
+        // start counting towards cleanup
+        SCR_ZombieCleanupManager cleanup = SCR_ZombieCleanupManager.GetInstance();
+        if (cleanup)
+            cleanup.Track(item, SCR_EZombieCleanupType.DROPPED_ITEM);
     }
 }
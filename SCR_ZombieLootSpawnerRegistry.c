@@ -0,0 +1,285 @@
+enum SCR_EZombieLootCategory
+{
+    FOOD,
+    WATER,
+    MEDICAL
+}
+
+// Spawners register themselves per category on init and leave on delete, so consumers never scan
+// the entity registry and spawners streamed in later are picked up automatically.
+// Emptied spawners are pushed onto a per-category FIFO ready queue; the respawn delay is constant
+// per category, so queue order is also due order and only due heads are ever looked at.
+// All spawners are also bucketed in a spatial grid, so streaming items in around players only
+// visits the cells near them.
+class SCR_ZombieLootSpawnerRegistry
+{
+    static const int CATEGORY_COUNT = 3;
+    static const float GRID_CELL_SIZE = 100;
+    
+    protected static ref SCR_ZombieLootSpawnerRegistry s_Instance;
+    
+    // Per SCR_EZombieLootCategory; each spawner remembers its index for O(1) swap removal
+    protected ref array<ref array<SCR_ZombieItemSpawnerComponent>> m_aSpawners = new array<ref array<SCR_ZombieItemSpawnerComponent>>();
+    
+    // Ready queues per category, consumed from the head index and compacted lazily
+    protected ref array<ref array<SCR_ZombieItemSpawnerComponent>> m_aReadyQueues = new array<ref array<SCR_ZombieItemSpawnerComponent>>();
+    protected ref array<ref array<float>> m_aReadyTimes = new array<ref array<float>>();
+    protected ref array<int> m_aQueueHeads = new array<int>();
+    
+    protected ref SCR_ZombieSpatialGrid m_Grid = new SCR_ZombieSpatialGrid(GRID_CELL_SIZE);
+    
+    // Materialized spawners, rebuilt each streaming pass; the second array is swapped in
+    protected ref array<SCR_ZombieItemSpawnerComponent> m_aMaterialized = new array<SCR_ZombieItemSpawnerComponent>();
+    protected ref array<SCR_ZombieItemSpawnerComponent> m_aStillMaterialized = new array<SCR_ZombieItemSpawnerComponent>();
+    protected ref array<Managed> m_aQueryResults = new array<Managed>();
+    protected int m_iStreamPass;
+    
+    static SCR_ZombieLootSpawnerRegistry GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieLootSpawnerRegistry();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieLootSpawnerRegistry FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    void SCR_ZombieLootSpawnerRegistry()
+    {
+        for (int i = 0; i < CATEGORY_COUNT; i++)
+        {
+            m_aSpawners.Insert(new array<SCR_ZombieItemSpawnerComponent>());
+            m_aReadyQueues.Insert(new array<SCR_ZombieItemSpawnerComponent>());
+            m_aReadyTimes.Insert(new array<float>());
+            m_aQueueHeads.Insert(0);
+        }
+    }
+    
+    void Register(SCR_ZombieItemSpawnerComponent spawner)
+    {
+        if (spawner.GetRegistryIndex() != -1)
+            return;
+            
+        array<SCR_ZombieItemSpawnerComponent> spawners = m_aSpawners[spawner.GetCategory()];
+        spawner.SetRegistryIndex(spawners.Insert(spawner));
+        m_Grid.Insert(spawner, spawner.GetOwner().GetOrigin());
+    }
+    
+    void Unregister(SCR_ZombieItemSpawnerComponent spawner)
+    {
+        int index = spawner.GetRegistryIndex();
+        if (index == -1)
+            return;
+            
+        array<SCR_ZombieItemSpawnerComponent> spawners = m_aSpawners[spawner.GetCategory()];
+        int last = spawners.Count() - 1;
+        if (index != last)
+        {
+            SCR_ZombieItemSpawnerComponent moved = spawners[last];
+            spawners[index] = moved;
+            if (moved)
+                moved.SetRegistryIndex(index);
+        }
+        
+        spawners.Remove(last);
+        spawner.SetRegistryIndex(-1);
+        
+        // Spawners never move, the cell is derived from the position again
+        m_Grid.Remove(spawner, m_Grid.GetCellKey(spawner.GetOwner().GetOrigin()));
+        m_aMaterialized.RemoveItem(spawner);
+    }
+    
+    array<SCR_ZombieItemSpawnerComponent> GetSpawners(SCR_EZombieLootCategory category)
+    {
+        return m_aSpawners[category];
+    }
+    
+    int GetSpawnerCount(SCR_EZombieLootCategory category)
+    {
+        return m_aSpawners[category].Count();
+    }
+    
+    void RollInitialItems()
+    {
+        foreach (array<SCR_ZombieItemSpawnerComponent> spawners : m_aSpawners)
+        {
+            foreach (SCR_ZombieItemSpawnerComponent spawner : spawners)
+            {
+                if (spawner)
+                    spawner.RollInitialItem();
+            }
+        }
+    }
+    
+    // Called when a spawner becomes empty, a spawner is queued at most once. Restored spawners pass
+    // how long ago they became empty and are sorted in so queue order stays due order; that time may
+    // lie before the world started.
+    void QueueRespawn(SCR_ZombieItemSpawnerComponent spawner, float emptiedAgeMs = 0)
+    {
+        if (spawner.IsQueuedForRespawn())
+            return;
+            
+        // Nothing could ever be drawn for it, requeueing would only spin
+        if (!spawner.HasLootTable())
+            return;
+            
+        float emptiedTime = GetGame().GetWorld().GetWorldTime() - emptiedAgeMs;
+        
+        SCR_EZombieLootCategory category = spawner.GetCategory();
+        array<float> times = m_aReadyTimes[category];
+        int index = times.Count();
+        
+        if (index > m_aQueueHeads[category] && times[index - 1] > emptiedTime)
+        {
+            // Binary search for the first later entry
+            int low = m_aQueueHeads[category];
+            int high = index;
+            while (low < high)
+            {
+                int middle = (low + high) / 2;
+                if (times[middle] <= emptiedTime)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            
+            index = low;
+        }
+        
+        m_aReadyQueues[category].InsertAt(spawner, index);
+        times.InsertAt(emptiedTime, index);
+        spawner.SetQueuedForRespawn(true, emptiedTime);
+    }
+    
+    // Takes a queued spawner out of the ready queue. Its entry stays behind and is skipped when it
+    // reaches the head, so a restore can requeue the spawner at a different time.
+    void CancelRespawn(SCR_ZombieItemSpawnerComponent spawner)
+    {
+        spawner.SetQueuedForRespawn(false);
+    }
+    
+    // Pops up to maxCount spawners of the category that became empty at or before the given world
+    // time, returns the number of queue entries consumed
+    int PopDue(SCR_EZombieLootCategory category, float emptiedBefore, notnull array<SCR_ZombieItemSpawnerComponent> outSpawners, int maxCount)
+    {
+        array<SCR_ZombieItemSpawnerComponent> queue = m_aReadyQueues[category];
+        array<float> times = m_aReadyTimes[category];
+        int head = m_aQueueHeads[category];
+        int consumed = 0;
+        
+        while (consumed < maxCount && head < queue.Count() && times[head] <= emptiedBefore)
+        {
+            SCR_ZombieItemSpawnerComponent spawner = queue[head];
+            float queuedTime = times[head];
+            head++;
+            consumed++;
+            
+            // Deleted spawners leave a null behind, cancelled or requeued ones an entry with a stale time
+            if (!spawner || !spawner.IsQueuedForRespawn() || spawner.GetEmptiedTime() != queuedTime)
+                continue;
+                
+            spawner.SetQueuedForRespawn(false);
+            outSpawners.Insert(spawner);
+        }
+        
+        // Drop the consumed prefix once it dominates the queue
+        if (head > 0 && head * 2 >= queue.Count())
+        {
+            int remaining = queue.Count() - head;
+            for (int i = 0; i < remaining; i++)
+            {
+                queue[i] = queue[head + i];
+                times[i] = times[head + i];
+            }
+            
+            queue.Resize(remaining);
+            times.Resize(remaining);
+            head = 0;
+        }
+        
+        m_aQueueHeads[category] = head;
+        return consumed;
+    }
+    
+    // Spawners never move, so a snapshot finds them again by position
+    SCR_ZombieItemSpawnerComponent FindSpawnerAt(vector position, float tolerance)
+    {
+        m_aQueryResults.Clear();
+        m_Grid.Query(position, tolerance, m_aQueryResults);
+        
+        foreach (Managed item : m_aQueryResults)
+        {
+            SCR_ZombieItemSpawnerComponent spawner = SCR_ZombieItemSpawnerComponent.Cast(item);
+            if (spawner && vector.DistanceSqXZ(position, spawner.GetOwner().GetOrigin()) <= tolerance * tolerance)
+                return spawner;
+        }
+        
+        return null;
+    }
+    
+    int GetQueueDepth(SCR_EZombieLootCategory category)
+    {
+        return m_aReadyQueues[category].Count() - m_aQueueHeads[category];
+    }
+    
+    int GetMaterializedCount()
+    {
+        return m_aMaterialized.Count();
+    }
+    
+    // Materializes spawners within radius of any listener and dematerializes the ones no listener is
+    // within releaseRadius of anymore; the gap between the two keeps items from flickering at the edge
+    void UpdateStreaming(notnull array<vector> listenerPositions, float radius, float releaseRadius)
+    {
+        float radiusSq = radius * radius;
+        float releaseRadiusSq = releaseRadius * releaseRadius;
+        m_aStillMaterialized.Clear();
+        m_iStreamPass++;
+        
+        foreach (vector listenerPosition : listenerPositions)
+        {
+            m_aQueryResults.Clear();
+            m_Grid.Query(listenerPosition, releaseRadius, m_aQueryResults);
+            
+            foreach (Managed item : m_aQueryResults)
+            {
+                SCR_ZombieItemSpawnerComponent spawner = SCR_ZombieItemSpawnerComponent.Cast(item);
+                if (!spawner)
+                    continue;
+                    
+                float distanceSq = vector.DistanceSqXZ(listenerPosition, spawner.GetOwner().GetOrigin());
+                if (distanceSq > releaseRadiusSq)
+                    continue;
+                    
+                if (!spawner.IsMaterialized())
+                {
+                    if (distanceSq > radiusSq)
+                        continue;
+                        
+                    spawner.Materialize();
+                }
+                
+                // Several listeners may see the same spawner, the pass stamp keeps it listed once
+                if (spawner.GetStreamPass() != m_iStreamPass)
+                {
+                    spawner.SetStreamPass(m_iStreamPass);
+                    m_aStillMaterialized.Insert(spawner);
+                }
+            }
+        }
+        
+        foreach (SCR_ZombieItemSpawnerComponent spawner : m_aMaterialized)
+        {
+            if (spawner && spawner.IsMaterialized() && spawner.GetStreamPass() != m_iStreamPass)
+                spawner.Dematerialize();
+        }
+        
+        array<SCR_ZombieItemSpawnerComponent> swap = m_aMaterialized;
+        m_aMaterialized = m_aStillMaterialized;
+        m_aStillMaterialized = swap;
+    }
+}
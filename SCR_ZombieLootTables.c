@@ -0,0 +1,302 @@
+enum SCR_EZombieLootRarity
+{
+    COMMON,
+    UNCOMMON,
+    RARE,
+    VERY_RARE
+}
+
+[BaseContainerProps()]
+class SCR_ZombieLootEntry
+{
+    [Attribute("", UIWidgets.ResourceNamePicker, "Item prefab", "et")]
+    ResourceName m_Prefab;
+    
+    [Attribute("1.0", UIWidgets.Auto, "Relative weight within the table")]
+    float m_fWeight;
+    
+    [Attribute("0", UIWidgets.ComboBox, "Rarity tier, scales the weight", "", ParamEnumArray.FromEnum(SCR_EZombieLootRarity))]
+    SCR_EZombieLootRarity m_eRarity;
+}
+
+[BaseContainerProps()]
+class SCR_ZombieLootTable
+{
+    [Attribute("", UIWidgets.EditBox, "ID spawners reference this table by")]
+    string m_sId;
+    
+    [Attribute("", UIWidgets.Object, "Items that can be drawn from this table")]
+    ref array<ref SCR_ZombieLootEntry> m_aEntries;
+}
+
+// Spawners of the base table inside the circle draw from the override table instead
+[BaseContainerProps()]
+class SCR_ZombieLootRegionOverride
+{
+    [Attribute("", UIWidgets.EditBox, "Table replaced inside the region")]
+    string m_sBaseTable;
+    
+    [Attribute("", UIWidgets.EditBox, "Table used inside the region")]
+    string m_sOverrideTable;
+    
+    [Attribute("0 0 0", UIWidgets.Coords, "Region center")]
+    vector m_vCenter;
+    
+    [Attribute("500.0", UIWidgets.Auto, "Region radius in meters")]
+    float m_fRadius;
+}
+
+[BaseContainerProps(configRoot: true)]
+class SCR_ZombieLootTableConfig
+{
+    [Attribute("", UIWidgets.Object, "Shared loot tables")]
+    ref array<ref SCR_ZombieLootTable> m_aTables;
+    
+    [Attribute("", UIWidgets.Object, "Per-region table overrides, the first matching one wins")]
+    ref array<ref SCR_ZombieLootRegionOverride> m_aRegionOverrides;
+    
+    [Attribute("1.0", UIWidgets.Auto, "Weight multiplier of common items")]
+    float m_fCommonWeight;
+    
+    [Attribute("0.4", UIWidgets.Auto, "Weight multiplier of uncommon items")]
+    float m_fUncommonWeight;
+    
+    [Attribute("0.1", UIWidgets.Auto, "Weight multiplier of rare items")]
+    float m_fRareWeight;
+    
+    [Attribute("0.02", UIWidgets.Auto, "Weight multiplier of very rare items")]
+    float m_fVeryRareWeight;
+}
+
+// Compiles the configured tables once into alias tables (Vose's method), so every draw is one
+// random slot plus one biased coin regardless of table size. All tables share flat arrays and are
+// addressed by index; spawners resolve their table ID, region overrides included, only once.
+class SCR_ZombieLootTableManager
+{
+    protected static ref SCR_ZombieLootTableManager s_Instance;
+    
+    protected ref map<string, int> m_mTableIndices = new map<string, int>();
+    protected ref array<int> m_aTableStarts = new array<int>();
+    protected ref array<int> m_aTableSizes = new array<int>();
+    
+    // Alias table slots of all tables back to back
+    protected ref array<ResourceName> m_aPrefabs = new array<ResourceName>();
+    protected ref array<float> m_aProbabilities = new array<float>();
+    protected ref array<int> m_aAliases = new array<int>();
+    
+    // First slot of every prefab, lets rolled items be stored as a plain index
+    protected ref map<ResourceName, int> m_mPrefabIndices = new map<ResourceName, int>();
+    
+    protected ref array<ref SCR_ZombieLootRegionOverride> m_aRegionOverrides = new array<ref SCR_ZombieLootRegionOverride>();
+    protected bool m_bLoaded;
+    
+    static SCR_ZombieLootTableManager GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieLootTableManager();
+            
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        s_Instance = null;
+    }
+    
+    bool IsLoaded()
+    {
+        return m_bLoaded;
+    }
+    
+    int GetTableCount()
+    {
+        return m_aTableStarts.Count();
+    }
+    
+    int GetPrefabCount()
+    {
+        return m_aPrefabs.Count();
+    }
+    
+    // Returns -1 for an empty or unknown prefab
+    int GetPrefabIndex(ResourceName prefab)
+    {
+        int index;
+        if (prefab.IsEmpty() || !m_mPrefabIndices.Find(prefab, index))
+            return -1;
+            
+        return index;
+    }
+    
+    ResourceName GetPrefab(int index)
+    {
+        if (index < 0 || index >= m_aPrefabs.Count())
+            return ResourceName.Empty;
+            
+        return m_aPrefabs[index];
+    }
+    
+    bool Load(ResourceName configPath)
+    {
+        Resource resource = Resource.Load(configPath);
+        if (!resource || !resource.IsValid())
+        {
+            Print(string.Format("[Zombies] Loot table config %1 could not be loaded", configPath), LogLevel.ERROR);
+            return false;
+        }
+        
+        SCR_ZombieLootTableConfig config = SCR_ZombieLootTableConfig.Cast(BaseContainerTools.CreateInstanceFromContainer(resource.GetResource().ToBaseContainer()));
+        if (!config)
+        {
+            Print(string.Format("[Zombies] %1 is not a loot table config", configPath), LogLevel.ERROR);
+            return false;
+        }
+        
+        Compile(config);
+        return true;
+    }
+    
+    void Compile(notnull SCR_ZombieLootTableConfig config)
+    {
+        m_mTableIndices.Clear();
+        m_aTableStarts.Clear();
+        m_aTableSizes.Clear();
+        m_aPrefabs.Clear();
+        m_aProbabilities.Clear();
+        m_aAliases.Clear();
+        m_mPrefabIndices.Clear();
+        m_aRegionOverrides.Clear();
+        
+        array<float> rarityWeights = {config.m_fCommonWeight, config.m_fUncommonWeight, config.m_fRareWeight, config.m_fVeryRareWeight};
+        
+        if (config.m_aTables)
+        {
+            foreach (SCR_ZombieLootTable table : config.m_aTables)
+            {
+                if (!table || table.m_sId.IsEmpty() || m_mTableIndices.Contains(table.m_sId))
+                    continue;
+                    
+                m_mTableIndices.Insert(table.m_sId, m_aTableStarts.Count());
+                CompileTable(table, rarityWeights);
+            }
+        }
+        
+        if (config.m_aRegionOverrides)
+        {
+            foreach (SCR_ZombieLootRegionOverride regionOverride : config.m_aRegionOverrides)
+            {
+                if (regionOverride)
+                    m_aRegionOverrides.Insert(regionOverride);
+            }
+        }
+        
+        m_bLoaded = true;
+        
+        // Spawners that registered before the tables existed still owe their initial roll
+        SCR_ZombieLootSpawnerRegistry.GetInstance().RollInitialItems();
+    }
+    
+    // Returns the table index for a spawner at the given position, -1 when the ID is unknown
+    int ResolveTable(string tableId, vector position)
+    {
+        foreach (SCR_ZombieLootRegionOverride regionOverride : m_aRegionOverrides)
+        {
+            if (regionOverride.m_sBaseTable != tableId)
+                continue;
+                
+            if (vector.DistanceSqXZ(position, regionOverride.m_vCenter) <= regionOverride.m_fRadius * regionOverride.m_fRadius)
+            {
+                tableId = regionOverride.m_sOverrideTable;
+                break;
+            }
+        }
+        
+        int tableIndex;
+        if (!m_mTableIndices.Find(tableId, tableIndex))
+            return -1;
+            
+        return tableIndex;
+    }
+    
+    ResourceName Draw(int tableIndex)
+    {
+        if (tableIndex < 0 || tableIndex >= m_aTableStarts.Count())
+            return ResourceName.Empty;
+            
+        int size = m_aTableSizes[tableIndex];
+        if (size == 0)
+            return ResourceName.Empty;
+            
+        int slot = m_aTableStarts[tableIndex] + Math.RandomInt(0, size);
+        if (Math.RandomFloat01() < m_aProbabilities[slot])
+            return m_aPrefabs[slot];
+            
+        return m_aPrefabs[m_aAliases[slot]];
+    }
+    
+    protected void CompileTable(SCR_ZombieLootTable table, array<float> rarityWeights)
+    {
+        int start = m_aPrefabs.Count();
+        array<float> weights = new array<float>();
+        float totalWeight = 0;
+        
+        if (table.m_aEntries)
+        {
+            foreach (SCR_ZombieLootEntry entry : table.m_aEntries)
+            {
+                if (!entry || entry.m_Prefab.IsEmpty())
+                    continue;
+                    
+                float weight = entry.m_fWeight * rarityWeights[entry.m_eRarity];
+                if (weight <= 0)
+                    continue;
+                    
+                if (!m_mPrefabIndices.Contains(entry.m_Prefab))
+                    m_mPrefabIndices.Insert(entry.m_Prefab, m_aPrefabs.Count());
+                    
+                m_aPrefabs.Insert(entry.m_Prefab);
+                m_aProbabilities.Insert(1.0);
+                m_aAliases.Insert(m_aPrefabs.Count() - 1);
+                weights.Insert(weight);
+                totalWeight += weight;
+            }
+        }
+        
+        int size = weights.Count();
+        m_aTableStarts.Insert(start);
+        m_aTableSizes.Insert(size);
+        if (size == 0)
+            return;
+            
+        // Scale so the average slot holds exactly 1, then pair each underfull slot with an overfull one
+        array<int> small = new array<int>();
+        array<int> large = new array<int>();
+        for (int i = 0; i < size; i++)
+        {
+            weights[i] = weights[i] * size / totalWeight;
+            if (weights[i] < 1.0)
+                small.Insert(i);
+            else
+                large.Insert(i);
+        }
+        
+        while (!small.IsEmpty() && !large.IsEmpty())
+        {
+            int less = small[small.Count() - 1];
+            small.Remove(small.Count() - 1);
+            int more = large[large.Count() - 1];
+            
+            m_aProbabilities[start + less] = weights[less];
+            m_aAliases[start + less] = start + more;
+            
+            weights[more] = weights[more] + weights[less] - 1.0;
+            if (weights[more] < 1.0)
+            {
+                large.Remove(large.Count() - 1);
+                small.Insert(more);
+            }
+        }
+        
+        // Whatever is left is full up to rounding error and keeps probability 1 on itself
+    }
+}
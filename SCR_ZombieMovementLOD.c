@@ -0,0 +1,397 @@
+enum SCR_EZombieMovementLOD
+{
+    FULL,
+    KINEMATIC,
+    POSITION_ONLY
+}
+
+// Movement and animation level of detail for spawned zombies. Near players they run the full
+// character controller, physics and AI; at mid range AI and physics are off and a ground-snapped
+// kinematic mover steps them with the animation graph in its low detail loop; far away the entity
+// is deactivated and only its position advances. Position and heading carry over between levels.
+class SCR_ZombieMovementLOD
+{
+    static const float STEP_INTERVAL_MS = 250;
+    static const int LEVEL_UPDATE_STEPS = 4;
+    static const int POSITION_ONLY_STEPS = 8;
+    static const float FULL_DISTANCE = 60;
+    static const float KINEMATIC_DISTANCE = 150;
+    static const float HYSTERESIS = 10;
+    static const float WANDER_SPEED = 1.8;
+    static const float CHASE_SPEED = 3.5;
+    static const float WANDER_TIME_MS = 10000;
+    
+    // Reduced zombies head for the nearest living player within this distance and wander otherwise
+    static const float PURSUIT_DISTANCE = KINEMATIC_DISTANCE;
+    static const int LEVEL_COUNT = 3;
+    
+    protected static ref SCR_ZombieMovementLOD s_Instance;
+    
+    protected ref map<IEntity, int> m_mSlots = new map<IEntity, int>();
+    
+    // Per zombie, dense and swap-removed
+    protected ref array<IEntity> m_aZombies = new array<IEntity>();
+    protected ref array<IEntity> m_aTargets = new array<IEntity>();
+    protected ref array<AIControlComponent> m_aAIControls = new array<AIControlComponent>();
+    protected ref array<AnimationComponent> m_aAnimations = new array<AnimationComponent>();
+    protected ref array<int> m_aLevels = new array<int>();
+    protected ref array<vector> m_aPositions = new array<vector>();
+    protected ref array<float> m_aHeadings = new array<float>();
+    protected ref array<float> m_aWanderTimes = new array<float>();
+    
+    // Per SCR_EZombieMovementLOD
+    protected ref array<int> m_aLevelCounts = {0, 0, 0};
+    
+    protected ref array<vector> m_aPlayerPositions = new array<vector>();
+    protected ref array<IEntity> m_aLivingPlayers = new array<IEntity>();
+    protected ref array<int> m_aPlayerIds = new array<int>();
+    
+    protected int m_iStepTimer;
+    protected int m_iStepCount;
+    protected int m_iTransitionCount;
+    
+    static SCR_ZombieMovementLOD GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieMovementLOD();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieMovementLOD FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        if (!s_Instance)
+            return;
+            
+        SCR_ZombieTimerWheel.CancelTimer(s_Instance.m_iStepTimer);
+        s_Instance = null;
+    }
+    
+    void SCR_ZombieMovementLOD()
+    {
+        m_iStepTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(Step, STEP_INTERVAL_MS, true);
+    }
+    
+    // Zombies start at full detail, the next level update moves them down if nobody is near
+    void Register(IEntity zombie, IEntity target)
+    {
+        if (!zombie || m_mSlots.Contains(zombie))
+            return;
+            
+        int slot = m_aZombies.Insert(zombie);
+        m_aTargets.Insert(target);
+        m_aAIControls.Insert(AIControlComponent.Cast(zombie.FindComponent(AIControlComponent)));
+        m_aAnimations.Insert(AnimationComponent.Cast(zombie.FindComponent(AnimationComponent)));
+        m_aLevels.Insert(SCR_EZombieMovementLOD.FULL);
+        m_aPositions.Insert(zombie.GetOrigin());
+        m_aHeadings.Insert(zombie.GetYawPitchRoll()[0]);
+        m_aWanderTimes.Insert(0);
+        m_mSlots.Insert(zombie, slot);
+        
+        m_aLevelCounts[SCR_EZombieMovementLOD.FULL] = m_aLevelCounts[SCR_EZombieMovementLOD.FULL] + 1;
+    }
+    
+    void Unregister(IEntity zombie)
+    {
+        int slot;
+        if (!m_mSlots.Find(zombie, slot))
+            return;
+            
+        m_aLevelCounts[m_aLevels[slot]] = m_aLevelCounts[m_aLevels[slot]] - 1;
+        RemoveSlot(slot);
+    }
+    
+    void Clear()
+    {
+        m_mSlots.Clear();
+        m_aZombies.Clear();
+        m_aTargets.Clear();
+        m_aAIControls.Clear();
+        m_aAnimations.Clear();
+        m_aLevels.Clear();
+        m_aPositions.Clear();
+        m_aHeadings.Clear();
+        m_aWanderTimes.Clear();
+        
+        for (int level = 0; level < LEVEL_COUNT; level++)
+        {
+            m_aLevelCounts[level] = 0;
+        }
+    }
+    
+    // The AI action skips its own update while the mover owns the zombie
+    bool IsFullSimulation(IEntity zombie)
+    {
+        int slot;
+        if (!m_mSlots.Find(zombie, slot))
+            return true;
+            
+        return m_aLevels[slot] == SCR_EZombieMovementLOD.FULL;
+    }
+    
+    int GetLevelCount(SCR_EZombieMovementLOD level)
+    {
+        return m_aLevelCounts[level];
+    }
+    
+    int GetTransitionCount()
+    {
+        return m_iTransitionCount;
+    }
+    
+    protected void Step(Managed context = null)
+    {
+        m_iStepCount++;
+        
+        if (m_iStepCount % LEVEL_UPDATE_STEPS == 0)
+            UpdateLevels();
+            
+        float now = GetGame().GetWorld().GetWorldTime();
+        
+        StepLevel(SCR_EZombieMovementLOD.KINEMATIC, STEP_INTERVAL_MS / 1000, now);
+        
+        if (m_iStepCount % POSITION_ONLY_STEPS != 0)
+            return;
+            
+        StepLevel(SCR_EZombieMovementLOD.POSITION_ONLY, STEP_INTERVAL_MS * POSITION_ONLY_STEPS / 1000, now);
+    }
+    
+    protected void UpdateLevels()
+    {
+        CollectPlayerPositions();
+        
+        for (int slot = m_aZombies.Count() - 1; slot >= 0; slot--)
+        {
+            IEntity zombie = m_aZombies[slot];
+            if (!zombie)
+            {
+                m_aLevelCounts[m_aLevels[slot]] = m_aLevelCounts[m_aLevels[slot]] - 1;
+                RemoveSlot(slot);
+                continue;
+            }
+            
+            int current = m_aLevels[slot];
+            vector position = GetPosition(slot);
+            float distance = Math.Sqrt(GetNearestPlayerDistanceSq(position));
+            
+            // Moving down a level needs the extra hysteresis distance, moving up does not
+            int wanted = SCR_EZombieMovementLOD.POSITION_ONLY;
+            if (distance < FULL_DISTANCE || (current == SCR_EZombieMovementLOD.FULL && distance < FULL_DISTANCE + HYSTERESIS))
+                wanted = SCR_EZombieMovementLOD.FULL;
+            else if (distance < KINEMATIC_DISTANCE || (current == SCR_EZombieMovementLOD.KINEMATIC && distance < KINEMATIC_DISTANCE + HYSTERESIS))
+                wanted = SCR_EZombieMovementLOD.KINEMATIC;
+                
+            if (wanted != current)
+                SetLevel(slot, wanted);
+                
+            // The spawn time target may have died or moved away, the AI resolves its own at full detail
+            if (wanted != SCR_EZombieMovementLOD.FULL)
+                m_aTargets[slot] = FindPursuitTarget(position);
+        }
+    }
+    
+    protected void SetLevel(int slot, SCR_EZombieMovementLOD level)
+    {
+        int current = m_aLevels[slot];
+        if (level == current)
+            return;
+            
+        IEntity zombie = m_aZombies[slot];
+        AIControlComponent aiControl = m_aAIControls[slot];
+        AnimationComponent anim = m_aAnimations[slot];
+        Physics physics = zombie.GetPhysics();
+        
+        // Leaving full detail, the mover continues from where the character controller left off
+        if (current == SCR_EZombieMovementLOD.FULL)
+        {
+            m_aPositions[slot] = zombie.GetOrigin();
+            m_aHeadings[slot] = zombie.GetYawPitchRoll()[0];
+            
+            if (aiControl)
+                aiControl.DeactivateAI();
+                
+            if (physics)
+                physics.SetActive(ActiveState.INACTIVE);
+        }
+        
+        if (current == SCR_EZombieMovementLOD.POSITION_ONLY)
+            zombie.SetFlags(EntityFlags.ACTIVE, false);
+            
+        ApplyTransform(slot);
+        
+        switch (level)
+        {
+            case SCR_EZombieMovementLOD.FULL:
+            {
+                if (physics)
+                    physics.SetActive(ActiveState.ACTIVE);
+                    
+                if (aiControl)
+                    aiControl.ActivateAI();
+                    
+                if (anim)
+                    anim.SetBool("isLowLOD", false);
+                    
+                break;
+            }
+            case SCR_EZombieMovementLOD.KINEMATIC:
+            {
+                if (anim)
+                    anim.SetBool("isLowLOD", true);
+                    
+                break;
+            }
+            case SCR_EZombieMovementLOD.POSITION_ONLY:
+            {
+                zombie.ClearFlags(EntityFlags.ACTIVE, false);
+                break;
+            }
+        }
+        
+        m_aLevelCounts[current] = m_aLevelCounts[current] - 1;
+        m_aLevelCounts[level] = m_aLevelCounts[level] + 1;
+        m_aLevels[slot] = level;
+        m_iTransitionCount++;
+    }
+    
+    protected void StepLevel(SCR_EZombieMovementLOD level, float seconds, float now)
+    {
+        BaseWorld world = GetGame().GetWorld();
+        
+        for (int slot = 0; slot < m_aZombies.Count(); slot++)
+        {
+            if (m_aLevels[slot] != level || !m_aZombies[slot])
+                continue;
+                
+            vector position = m_aPositions[slot];
+            float speed = WANDER_SPEED;
+            
+            // Same goals as the AI action, head for the target or wander in a new direction now and then
+            IEntity target = m_aTargets[slot];
+            if (target)
+            {
+                vector toTarget = target.GetOrigin() - position;
+                m_aHeadings[slot] = Math.Atan2(toTarget[0], toTarget[2]) * Math.RAD2DEG;
+                speed = CHASE_SPEED;
+            }
+            else if (now > m_aWanderTimes[slot])
+            {
+                m_aHeadings[slot] = Math.RandomFloat(-180, 180);
+                m_aWanderTimes[slot] = now + WANDER_TIME_MS;
+            }
+            
+            float headingRad = m_aHeadings[slot] * Math.DEG2RAD;
+            position[0] = position[0] + Math.Sin(headingRad) * speed * seconds;
+            position[2] = position[2] + Math.Cos(headingRad) * speed * seconds;
+            position[1] = world.GetSurfaceY(position[0], position[2]);
+            m_aPositions[slot] = position;
+            
+            // Despawn, persistence and the spawn bookkeeping read the entity origin
+            ApplyTransform(slot);
+        }
+    }
+    
+    protected void ApplyTransform(int slot)
+    {
+        vector transform[4];
+        Math3D.AnglesToMatrix(Vector(m_aHeadings[slot], 0, 0), transform);
+        transform[3] = m_aPositions[slot];
+        m_aZombies[slot].SetWorldTransform(transform);
+    }
+    
+    protected vector GetPosition(int slot)
+    {
+        if (m_aLevels[slot] == SCR_EZombieMovementLOD.FULL)
+            return m_aZombies[slot].GetOrigin();
+            
+        return m_aPositions[slot];
+    }
+    
+    protected void RemoveSlot(int slot)
+    {
+        IEntity zombie = m_aZombies[slot];
+        m_mSlots.Remove(zombie);
+        
+        int last = m_aZombies.Count() - 1;
+        if (slot != last)
+        {
+            m_aZombies[slot] = m_aZombies[last];
+            m_aTargets[slot] = m_aTargets[last];
+            m_aAIControls[slot] = m_aAIControls[last];
+            m_aAnimations[slot] = m_aAnimations[last];
+            m_aLevels[slot] = m_aLevels[last];
+            m_aPositions[slot] = m_aPositions[last];
+            m_aHeadings[slot] = m_aHeadings[last];
+            m_aWanderTimes[slot] = m_aWanderTimes[last];
+            
+            if (m_aZombies[slot])
+                m_mSlots.Set(m_aZombies[slot], slot);
+        }
+        
+        m_aZombies.Remove(last);
+        m_aTargets.Remove(last);
+        m_aAIControls.Remove(last);
+        m_aAnimations.Remove(last);
+        m_aLevels.Remove(last);
+        m_aPositions.Remove(last);
+        m_aHeadings.Remove(last);
+        m_aWanderTimes.Remove(last);
+    }
+    
+    protected void CollectPlayerPositions()
+    {
+        m_aPlayerIds.Clear();
+        m_aPlayerPositions.Clear();
+        m_aLivingPlayers.Clear();
+        
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        playerManager.GetPlayers(m_aPlayerIds);
+        foreach (int playerId : m_aPlayerIds)
+        {
+            IEntity playerEntity = playerManager.GetPlayerControlledEntity(playerId);
+            if (!playerEntity)
+                continue;
+                
+            m_aPlayerPositions.Insert(playerEntity.GetOrigin());
+            
+            DamageManagerComponent damageManager = DamageManagerComponent.Cast(playerEntity.FindComponent(DamageManagerComponent));
+            if (!damageManager || damageManager.GetState() != EDamageState.DESTROYED)
+                m_aLivingPlayers.Insert(playerEntity);
+        }
+    }
+    
+    // Nearest living player within the pursuit distance, null to wander
+    protected IEntity FindPursuitTarget(vector position)
+    {
+        IEntity nearest;
+        float nearestSq = PURSUIT_DISTANCE * PURSUIT_DISTANCE;
+        foreach (IEntity player : m_aLivingPlayers)
+        {
+            float distanceSq = vector.DistanceSq(position, player.GetOrigin());
+            if (distanceSq < nearestSq)
+            {
+                nearestSq = distanceSq;
+                nearest = player;
+            }
+        }
+        
+        return nearest;
+    }
+    
+    protected float GetNearestPlayerDistanceSq(vector position)
+    {
+        float nearestSq = float.MAX;
+        foreach (vector playerPosition : m_aPlayerPositions)
+        {
+            nearestSq = Math.Min(nearestSq, vector.DistanceSq(position, playerPosition));
+        }
+        
+        return nearestSq;
+    }
+}
@@ -0,0 +1,348 @@
+// Zombies one client currently receives
+class SCR_ZombieRelevancyClient
+{
+    int m_iPlayerId;
+    RplIdentity m_Identity;
+    int m_iPass;
+    ref set<RplComponent> m_Relevant = new set<RplComponent>();
+    ref set<RplComponent> m_Next = new set<RplComponent>();
+}
+
+// Per client replication relevancy of spawned zombies. Live zombies are bucketed in a spatial
+// grid; every tick each client is matched against the cells around its player and only zombies
+// within its streaming radius are streamed to it, a wide radius inside the view cone and a short
+// one behind. Everything else is streamed out for that client and costs it no traffic at all.
+class SCR_ZombieNetRelevancy
+{
+    static const float TICK_INTERVAL_MS = 500;
+    static const float GRID_CELL_SIZE = 100;
+    static const float IN_VIEW_RADIUS = 200;
+    static const float OUT_OF_VIEW_RADIUS = 80;
+    static const float HYSTERESIS = 20;
+    
+    // Cosine of half the view cone, 60 degrees either side of the heading
+    static const float VIEW_CONE_COS = 0.5;
+    
+    // Zombies inside the view cone this close count as seen by the player
+    static const float SEEN_RADIUS = 150;
+    
+    // Rough replication cost of one streamed zombie: transform, animation and sound events
+    static const int ESTIMATED_BYTES_PER_SECOND = 150;
+    
+    protected static ref SCR_ZombieNetRelevancy s_Instance;
+    
+    protected ref SCR_ZombieSpatialGrid m_Grid = new SCR_ZombieSpatialGrid(GRID_CELL_SIZE);
+    protected ref map<IEntity, int> m_mSlots = new map<IEntity, int>();
+    protected ref array<IEntity> m_aZombies = new array<IEntity>();
+    protected ref array<RplComponent> m_aRpls = new array<RplComponent>();
+    protected ref array<int> m_aCellKeys = new array<int>();
+    protected ref array<bool> m_aSeen = new array<bool>();
+    
+    protected ref map<int, ref SCR_ZombieRelevancyClient> m_mClients = new map<int, ref SCR_ZombieRelevancyClient>();
+    
+    // Per tick scratch
+    protected ref array<Managed> m_aQueryResults = new array<Managed>();
+    protected ref array<int> m_aPlayerIds = new array<int>();
+    protected ref array<int> m_aLeftClients = new array<int>();
+    
+    protected int m_iTickTimer;
+    protected int m_iPass;
+    protected int m_iRelevantPairs;
+    protected int m_iStreamedInCount;
+    protected int m_iStreamedOutCount;
+    
+    static SCR_ZombieNetRelevancy GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieNetRelevancy();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieNetRelevancy FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        if (!s_Instance)
+            return;
+            
+        SCR_ZombieTimerWheel.CancelTimer(s_Instance.m_iTickTimer);
+        s_Instance = null;
+    }
+    
+    void SCR_ZombieNetRelevancy()
+    {
+        m_iTickTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(Tick, TICK_INTERVAL_MS, true);
+    }
+    
+    // New zombies start streamed out for everyone, the next tick streams them to nearby clients
+    void Register(IEntity zombie)
+    {
+        if (!zombie || m_mSlots.Contains(zombie))
+            return;
+            
+        RplComponent rpl = RplComponent.Cast(zombie.FindComponent(RplComponent));
+        if (!rpl)
+            return;
+            
+        int slot = m_aZombies.Insert(zombie);
+        m_aRpls.Insert(rpl);
+        m_aCellKeys.Insert(m_Grid.Insert(rpl, zombie.GetOrigin()));
+        m_aSeen.Insert(false);
+        m_mSlots.Insert(zombie, slot);
+        
+        foreach (int playerId, SCR_ZombieRelevancyClient client : m_mClients)
+        {
+            rpl.EnableStreamingConNode(client.m_Identity, false);
+        }
+    }
+    
+    // Corpses and despawning zombies go back to the engine's default relevancy
+    void Unregister(IEntity zombie)
+    {
+        int slot;
+        if (!m_mSlots.Find(zombie, slot))
+            return;
+            
+        RplComponent rpl = m_aRpls[slot];
+        m_Grid.Remove(rpl, m_aCellKeys[slot]);
+        
+        foreach (int playerId, SCR_ZombieRelevancyClient client : m_mClients)
+        {
+            int index = client.m_Relevant.Find(rpl);
+            if (index != -1)
+            {
+                client.m_Relevant.Remove(index);
+                continue;
+            }
+            
+            if (rpl)
+                rpl.EnableStreamingConNode(client.m_Identity, true);
+        }
+        
+        m_mSlots.Remove(zombie);
+        
+        int last = m_aZombies.Count() - 1;
+        if (slot != last)
+        {
+            m_aZombies[slot] = m_aZombies[last];
+            m_aRpls[slot] = m_aRpls[last];
+            m_aCellKeys[slot] = m_aCellKeys[last];
+            m_aSeen[slot] = m_aSeen[last];
+            m_mSlots.Set(m_aZombies[slot], slot);
+        }
+        
+        m_aZombies.Remove(last);
+        m_aRpls.Remove(last);
+        m_aCellKeys.Remove(last);
+        m_aSeen.Remove(last);
+    }
+    
+    void Clear()
+    {
+        m_Grid.Clear();
+        m_mSlots.Clear();
+        m_aZombies.Clear();
+        m_aRpls.Clear();
+        m_aCellKeys.Clear();
+        m_aSeen.Clear();
+        m_mClients.Clear();
+    }
+    
+    // Whether any player had the zombie in view since it was registered
+    bool WasSeen(IEntity zombie)
+    {
+        int slot;
+        if (!m_mSlots.Find(zombie, slot))
+            return false;
+            
+        return m_aSeen[slot];
+    }
+    
+    // Live zombies within radius of a position, for spawn budgeting
+    int CountNear(vector center, float radius)
+    {
+        m_aQueryResults.Clear();
+        m_Grid.Query(center, radius, m_aQueryResults);
+        
+        float radiusSq = radius * radius;
+        int count = 0;
+        foreach (Managed item : m_aQueryResults)
+        {
+            RplComponent rpl = RplComponent.Cast(item);
+            if (rpl && rpl.GetEntity() && vector.DistanceSqXZ(center, rpl.GetEntity().GetOrigin()) <= radiusSq)
+                count++;
+        }
+        
+        return count;
+    }
+    
+    int GetClientCount()
+    {
+        return m_mClients.Count();
+    }
+    
+    // Average number of zombies streamed to a client
+    float GetAverageRelevantCount()
+    {
+        if (m_mClients.IsEmpty())
+            return 0;
+            
+        float relevantPairs = m_iRelevantPairs;
+        return relevantPairs / m_mClients.Count();
+    }
+    
+    // Estimated zombie traffic per client with relevancy, and if every zombie went to every client
+    float GetEstimatedBytesPerClient()
+    {
+        return GetAverageRelevantCount() * ESTIMATED_BYTES_PER_SECOND;
+    }
+    
+    float GetEstimatedUnfilteredBytesPerClient()
+    {
+        return m_aZombies.Count() * ESTIMATED_BYTES_PER_SECOND;
+    }
+    
+    int GetStreamedInCount()
+    {
+        return m_iStreamedInCount;
+    }
+    
+    int GetStreamedOutCount()
+    {
+        return m_iStreamedOutCount;
+    }
+    
+    protected void Tick(Managed context = null)
+    {
+        m_iPass++;
+        m_iRelevantPairs = 0;
+        
+        // Rebucket zombies that walked into another cell
+        for (int slot = 0; slot < m_aZombies.Count(); slot++)
+        {
+            if (m_aZombies[slot])
+                m_aCellKeys[slot] = m_Grid.Move(m_aRpls[slot], m_aCellKeys[slot], m_aZombies[slot].GetOrigin());
+        }
+        
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        m_aPlayerIds.Clear();
+        playerManager.GetPlayers(m_aPlayerIds);
+        foreach (int playerId : m_aPlayerIds)
+        {
+            IEntity playerEntity = playerManager.GetPlayerControlledEntity(playerId);
+            PlayerController controller = playerManager.GetPlayerController(playerId);
+            if (!playerEntity || !controller)
+                continue;
+                
+            SCR_ZombieRelevancyClient client = m_mClients.Get(playerId);
+            if (!client)
+                client = AddClient(playerId, controller.GetRplIdentity());
+                
+            client.m_iPass = m_iPass;
+            UpdateClient(client, playerEntity);
+            m_iRelevantPairs += client.m_Relevant.Count();
+        }
+        
+        // Disconnected clients
+        m_aLeftClients.Clear();
+        foreach (int clientId, SCR_ZombieRelevancyClient knownClient : m_mClients)
+        {
+            if (knownClient.m_iPass != m_iPass)
+                m_aLeftClients.Insert(clientId);
+        }
+        
+        foreach (int leftId : m_aLeftClients)
+        {
+            m_mClients.Remove(leftId);
+        }
+    }
+    
+    // A joining client starts with every zombie streamed out, its first update streams the near ones in
+    protected SCR_ZombieRelevancyClient AddClient(int playerId, RplIdentity identity)
+    {
+        SCR_ZombieRelevancyClient client = new SCR_ZombieRelevancyClient();
+        client.m_iPlayerId = playerId;
+        client.m_Identity = identity;
+        m_mClients.Insert(playerId, client);
+        
+        foreach (RplComponent rpl : m_aRpls)
+        {
+            if (rpl)
+                rpl.EnableStreamingConNode(identity, false);
+        }
+        
+        return client;
+    }
+    
+    protected void MarkSeen(IEntity zombie)
+    {
+        int slot;
+        if (m_mSlots.Find(zombie, slot))
+            m_aSeen[slot] = true;
+    }
+    
+    protected void UpdateClient(SCR_ZombieRelevancyClient client, IEntity playerEntity)
+    {
+        vector center = playerEntity.GetOrigin();
+        vector forward = playerEntity.GetWorldTransformAxis(2);
+        forward[1] = 0;
+        forward.Normalize();
+        
+        m_aQueryResults.Clear();
+        m_Grid.Query(center, IN_VIEW_RADIUS + HYSTERESIS, m_aQueryResults);
+        
+        client.m_Next.Clear();
+        foreach (Managed item : m_aQueryResults)
+        {
+            RplComponent rpl = RplComponent.Cast(item);
+            if (!rpl || !rpl.GetEntity())
+                continue;
+                
+            vector toZombie = rpl.GetEntity().GetOrigin() - center;
+            toZombie[1] = 0;
+            float distance = toZombie.Length();
+            
+            float radius = OUT_OF_VIEW_RADIUS;
+            if (distance > 0 && vector.Dot(forward, toZombie) / distance >= VIEW_CONE_COS)
+            {
+                radius = IN_VIEW_RADIUS;
+                if (distance <= SEEN_RADIUS)
+                    MarkSeen(rpl.GetEntity());
+            }
+            
+            // Zombies already streamed stay a little longer so edge cases do not flap
+            if (client.m_Relevant.Contains(rpl))
+                radius += HYSTERESIS;
+                
+            if (distance <= radius)
+                client.m_Next.Insert(rpl);
+        }
+        
+        foreach (RplComponent leaving : client.m_Relevant)
+        {
+            if (leaving && !client.m_Next.Contains(leaving))
+            {
+                leaving.EnableStreamingConNode(client.m_Identity, false);
+                m_iStreamedOutCount++;
+            }
+        }
+        
+        foreach (RplComponent entering : client.m_Next)
+        {
+            if (!client.m_Relevant.Contains(entering))
+            {
+                entering.EnableStreamingConNode(client.m_Identity, true);
+                m_iStreamedInCount++;
+            }
+        }
+        
+        set<RplComponent> previous = client.m_Relevant;
+        client.m_Relevant = client.m_Next;
+        client.m_Next = previous;
+    }
+}
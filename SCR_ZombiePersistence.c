@@ -0,0 +1,506 @@
+enum SCR_EZombieSnapshotRecord
+{
+    END,
+    SPAWNER,
+    ZOMBIE,
+    PLAYER
+}
+
+class SCR_ZombiePlayerSnapshot
+{
+    int m_iIdentity;
+    float m_fHunger;
+    float m_fThirst;
+    float m_fInfection;
+}
+
+// Binary warm start snapshot of loot spawners, the zombie population and player survival and
+// infection values. The file is a header followed by tagged fixed-size records, so it can be
+// written and read a chunk of records per tick without ever holding it in memory. Snapshots are
+// written to a temporary file first and only replace the previous one once complete.
+class SCR_ZombiePersistence
+{
+    static const int SNAPSHOT_MAGIC = 0x5A534E50;
+    static const int SNAPSHOT_VERSION = 1;
+    static const int RECORDS_PER_CHUNK = 64;
+    static const string SNAPSHOT_PATH = "$profile:ZombieSnapshot.bin";
+    static const string SNAPSHOT_TEMP_PATH = "$profile:ZombieSnapshot.tmp";
+    
+    // Spawner positions are stored in decimeters, enough to tell neighbouring spawners apart
+    static const float SPAWNER_POSITION_SCALE = 10;
+    
+    protected static ref SCR_ZombiePersistence s_Instance;
+    
+    protected ZombieManager m_ZombieManager;
+    protected int m_iSaveTimer;
+    protected int m_iWriteTimer;
+    protected int m_iReadTimer;
+    
+    // Write cursor, spawners are walked category by category, then zombies, then players
+    protected FileHandle m_WriteFile;
+    protected SCR_EZombieSnapshotRecord m_eWritePhase;
+    protected int m_iWriteCategory;
+    protected int m_iWriteIndex;
+    protected int m_iWriteRecordCount;
+    protected ref array<ref SCR_ZombiePlayerSnapshot> m_aWritePlayers = new array<ref SCR_ZombiePlayerSnapshot>();
+    
+    protected FileHandle m_ReadFile;
+    protected bool m_bRestoreLoot;
+    protected int m_iReadRecordCount;
+    
+    // Restored players by identity hash, applied once they spawn
+    protected ref map<int, ref SCR_ZombiePlayerSnapshot> m_mRestoredPlayers = new map<int, ref SCR_ZombiePlayerSnapshot>();
+    
+    protected int m_iLastSnapshotRecords;
+    protected int m_iLastSnapshotChunks;
+    protected int m_iWriteChunks;
+    
+    static SCR_ZombiePersistence GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombiePersistence();
+            
+        return s_Instance;
+    }
+    
+    // Null when persistence is disabled or shut down
+    static SCR_ZombiePersistence FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        if (!s_Instance)
+            return;
+            
+        s_Instance.Stop();
+        s_Instance = null;
+    }
+    
+    // Starts streaming the previous snapshot in and schedules periodic snapshots
+    void Start(ZombieManager zombieManager, float snapshotInterval)
+    {
+        m_ZombieManager = zombieManager;
+        BeginLoad();
+        
+        m_iSaveTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(BeginSnapshot, snapshotInterval * 1000, true);
+    }
+    
+    int GetLastSnapshotRecords()
+    {
+        return m_iLastSnapshotRecords;
+    }
+    
+    int GetLastSnapshotChunks()
+    {
+        return m_iLastSnapshotChunks;
+    }
+    
+    int GetRestoredRecordCount()
+    {
+        return m_iReadRecordCount;
+    }
+    
+    bool IsLoading()
+    {
+        return m_ReadFile != null;
+    }
+    
+    // Applies the restored survival and infection values to a player entering the game
+    void RestorePlayer(IEntity playerEntity)
+    {
+        int identity = GetPlayerIdentity(playerEntity);
+        SCR_ZombiePlayerSnapshot snapshot = m_mRestoredPlayers.Get(identity);
+        if (!snapshot)
+            return;
+            
+        SCR_ZombieSurvivalComponent survival = SCR_ZombieSurvivalComponent.Cast(playerEntity.FindComponent(SCR_ZombieSurvivalComponent));
+        if (survival)
+            survival.SetSurvivalValues(snapshot.m_fHunger, snapshot.m_fThirst);
+            
+        SCR_ZombieInfectionManager infectionManager = SCR_ZombieInfectionManager.GetInstance();
+        if (infectionManager)
+            infectionManager.SetInfectionLevel(playerEntity, snapshot.m_fInfection);
+            
+        m_mRestoredPlayers.Remove(identity);
+    }
+    
+    protected void Stop()
+    {
+        SCR_ZombieTimerWheel.CancelTimer(m_iSaveTimer);
+        SCR_ZombieTimerWheel.CancelTimer(m_iWriteTimer);
+        SCR_ZombieTimerWheel.CancelTimer(m_iReadTimer);
+        
+        // An unfinished snapshot is dropped, the previous complete one stays in place
+        if (m_WriteFile)
+        {
+            m_WriteFile.Close();
+            m_WriteFile = null;
+            FileIO.DeleteFile(SNAPSHOT_TEMP_PATH);
+        }
+        
+        if (m_ReadFile)
+        {
+            m_ReadFile.Close();
+            m_ReadFile = null;
+        }
+    }
+    
+    protected void BeginSnapshot(Managed context = null)
+    {
+        // Still writing the previous one, or restoring, which would snapshot a half loaded world
+        if (m_WriteFile || m_ReadFile)
+            return;
+            
+        m_WriteFile = FileIO.OpenFile(SNAPSHOT_TEMP_PATH, FileMode.WRITE);
+        if (!m_WriteFile)
+            return;
+            
+        WriteInt(SNAPSHOT_MAGIC);
+        WriteInt(SNAPSHOT_VERSION);
+        WriteInt(SCR_ZombieLootTableManager.GetInstance().GetPrefabCount());
+        
+        m_eWritePhase = SCR_EZombieSnapshotRecord.SPAWNER;
+        m_iWriteCategory = 0;
+        m_iWriteIndex = 0;
+        m_iWriteRecordCount = 0;
+        m_iWriteChunks = 0;
+        WriteChunk();
+    }
+    
+    protected void WriteChunk(Managed context = null)
+    {
+        m_iWriteChunks++;
+        int budget = RECORDS_PER_CHUNK;
+        
+        while (budget > 0 && m_eWritePhase != SCR_EZombieSnapshotRecord.END)
+        {
+            if (WriteNextRecord())
+            {
+                budget--;
+                m_iWriteRecordCount++;
+            }
+        }
+        
+        if (m_eWritePhase != SCR_EZombieSnapshotRecord.END)
+        {
+            m_iWriteTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(WriteChunk, 0);
+            return;
+        }
+        
+        WriteInt(SCR_EZombieSnapshotRecord.END);
+        m_WriteFile.Close();
+        m_WriteFile = null;
+        
+        FileIO.CopyFile(SNAPSHOT_TEMP_PATH, SNAPSHOT_PATH);
+        FileIO.DeleteFile(SNAPSHOT_TEMP_PATH);
+        
+        m_iLastSnapshotRecords = m_iWriteRecordCount;
+        m_iLastSnapshotChunks = m_iWriteChunks;
+    }
+    
+    // Advances the cursor by one source element, returns whether a record was written
+    protected bool WriteNextRecord()
+    {
+        switch (m_eWritePhase)
+        {
+            case SCR_EZombieSnapshotRecord.SPAWNER:
+                return WriteNextSpawner();
+            case SCR_EZombieSnapshotRecord.ZOMBIE:
+                return WriteNextZombie();
+            case SCR_EZombieSnapshotRecord.PLAYER:
+                return WriteNextPlayer();
+        }
+        
+        return false;
+    }
+    
+    protected bool WriteNextSpawner()
+    {
+        if (m_iWriteCategory >= SCR_ZombieLootSpawnerRegistry.CATEGORY_COUNT)
+        {
+            NextWritePhase(SCR_EZombieSnapshotRecord.ZOMBIE);
+            return false;
+        }
+        
+        array<SCR_ZombieItemSpawnerComponent> spawners = SCR_ZombieLootSpawnerRegistry.GetInstance().GetSpawners(m_iWriteCategory);
+        if (m_iWriteIndex >= spawners.Count())
+        {
+            m_iWriteCategory++;
+            m_iWriteIndex = 0;
+            return false;
+        }
+        
+        SCR_ZombieItemSpawnerComponent spawner = spawners[m_iWriteIndex];
+        m_iWriteIndex++;
+        if (!spawner)
+            return false;
+            
+        // Due times are stored as the age of the empty slot, world time restarts with the server
+        int emptiedAge = -1;
+        if (spawner.IsQueuedForRespawn())
+            emptiedAge = GetGame().GetWorld().GetWorldTime() - spawner.GetEmptiedTime();
+            
+        vector position = spawner.GetOwner().GetOrigin();
+        WriteInt(SCR_EZombieSnapshotRecord.SPAWNER);
+        WriteInt(Math.Round(position[0] * SPAWNER_POSITION_SCALE));
+        WriteInt(Math.Round(position[2] * SPAWNER_POSITION_SCALE));
+        WriteInt(SCR_ZombieLootTableManager.GetInstance().GetPrefabIndex(spawner.GetRolledItem()));
+        WriteInt(emptiedAge);
+        return true;
+    }
+    
+    // Live zombies first, then the virtual population
+    protected bool WriteNextZombie()
+    {
+        int liveCount;
+        SCR_ZombieVirtualPopulation virtualPopulation;
+        if (m_ZombieManager)
+        {
+            liveCount = m_ZombieManager.GetZombies().Count();
+            virtualPopulation = m_ZombieManager.GetVirtualPopulation();
+        }
+        
+        if (!m_ZombieManager || m_iWriteIndex >= liveCount + virtualPopulation.Count())
+        {
+            NextWritePhase(SCR_EZombieSnapshotRecord.PLAYER);
+            CollectPlayers();
+            return false;
+        }
+        
+        vector position;
+        if (m_iWriteIndex < liveCount)
+        {
+            IEntity zombie = m_ZombieManager.GetZombies()[m_iWriteIndex];
+            m_iWriteIndex++;
+            if (!zombie)
+                return false;
+                
+            position = zombie.GetOrigin();
+        }
+        else
+        {
+            position = virtualPopulation.GetPosition(m_iWriteIndex - liveCount);
+            m_iWriteIndex++;
+        }
+        
+        WriteInt(SCR_EZombieSnapshotRecord.ZOMBIE);
+        WriteFloat(position[0]);
+        WriteFloat(position[1]);
+        WriteFloat(position[2]);
+        return true;
+    }
+    
+    protected bool WriteNextPlayer()
+    {
+        if (m_iWriteIndex >= m_aWritePlayers.Count())
+        {
+            m_aWritePlayers.Clear();
+            NextWritePhase(SCR_EZombieSnapshotRecord.END);
+            return false;
+        }
+        
+        SCR_ZombiePlayerSnapshot snapshot = m_aWritePlayers[m_iWriteIndex];
+        m_iWriteIndex++;
+        
+        WriteInt(SCR_EZombieSnapshotRecord.PLAYER);
+        WriteInt(snapshot.m_iIdentity);
+        WriteFloat(snapshot.m_fHunger);
+        WriteFloat(snapshot.m_fThirst);
+        WriteFloat(snapshot.m_fInfection);
+        return true;
+    }
+    
+    protected void NextWritePhase(SCR_EZombieSnapshotRecord phase)
+    {
+        m_eWritePhase = phase;
+        m_iWriteIndex = 0;
+    }
+    
+    // Players are few, so their values are captured at once; restored players who have not come
+    // back yet are carried over so their state survives another restart
+    protected void CollectPlayers()
+    {
+        m_aWritePlayers.Clear();
+        
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        array<int> playerIds = new array<int>();
+        playerManager.GetPlayers(playerIds);
+        
+        SCR_ZombieInfectionManager infectionManager = SCR_ZombieInfectionManager.GetInstance();
+        foreach (int playerId : playerIds)
+        {
+            IEntity playerEntity = playerManager.GetPlayerControlledEntity(playerId);
+            if (!playerEntity)
+                continue;
+                
+            SCR_ZombiePlayerSnapshot snapshot = new SCR_ZombiePlayerSnapshot();
+            snapshot.m_iIdentity = GetPlayerIdentity(playerEntity);
+            snapshot.m_fHunger = 100;
+            snapshot.m_fThirst = 100;
+            
+            SCR_ZombieSurvivalComponent survival = SCR_ZombieSurvivalComponent.Cast(playerEntity.FindComponent(SCR_ZombieSurvivalComponent));
+            if (survival)
+            {
+                snapshot.m_fHunger = survival.GetHunger();
+                snapshot.m_fThirst = survival.GetThirst();
+            }
+            
+            if (infectionManager)
+                snapshot.m_fInfection = infectionManager.GetInfectionLevel(playerEntity);
+                
+            m_aWritePlayers.Insert(snapshot);
+        }
+        
+        foreach (int identity, SCR_ZombiePlayerSnapshot restored : m_mRestoredPlayers)
+        {
+            m_aWritePlayers.Insert(restored);
+        }
+    }
+    
+    protected void BeginLoad()
+    {
+        if (!FileIO.FileExists(SNAPSHOT_PATH))
+            return;
+            
+        m_ReadFile = FileIO.OpenFile(SNAPSHOT_PATH, FileMode.READ);
+        if (!m_ReadFile)
+            return;
+            
+        if (ReadInt() != SNAPSHOT_MAGIC || ReadInt() != SNAPSHOT_VERSION)
+        {
+            Print(string.Format("[Zombies] %1 is not a compatible snapshot, starting cold", SNAPSHOT_PATH), LogLevel.WARNING);
+            FinishLoad();
+            return;
+        }
+        
+        // Rolled items are stored as loot table slots, which only hold while the tables are unchanged
+        m_bRestoreLoot = ReadInt() == SCR_ZombieLootTableManager.GetInstance().GetPrefabCount();
+        m_iReadRecordCount = 0;
+        ReadChunk();
+    }
+    
+    protected void ReadChunk(Managed context = null)
+    {
+        for (int i = 0; i < RECORDS_PER_CHUNK; i++)
+        {
+            if (!ReadNextRecord())
+            {
+                FinishLoad();
+                return;
+            }
+            
+            m_iReadRecordCount++;
+        }
+        
+        m_iReadTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(ReadChunk, 0);
+    }
+    
+    // Returns false at the end of the snapshot
+    protected bool ReadNextRecord()
+    {
+        int tag = SCR_EZombieSnapshotRecord.END;
+        if (m_ReadFile.Read(tag, 4) < 4)
+            return false;
+            
+        switch (tag)
+        {
+            case SCR_EZombieSnapshotRecord.SPAWNER:
+                ReadSpawner();
+                return true;
+            case SCR_EZombieSnapshotRecord.ZOMBIE:
+                ReadZombie();
+                return true;
+            case SCR_EZombieSnapshotRecord.PLAYER:
+                ReadPlayer();
+                return true;
+        }
+        
+        return false;
+    }
+    
+    protected void ReadSpawner()
+    {
+        float x = ReadInt() / SPAWNER_POSITION_SCALE;
+        float z = ReadInt() / SPAWNER_POSITION_SCALE;
+        int prefabIndex = ReadInt();
+        int emptiedAge = ReadInt();
+        
+        if (!m_bRestoreLoot)
+            return;
+            
+        SCR_ZombieItemSpawnerComponent spawner = SCR_ZombieLootSpawnerRegistry.GetInstance().FindSpawnerAt(Vector(x, 0, z), 1 / SPAWNER_POSITION_SCALE);
+        if (!spawner)
+            return;
+            
+        // An empty spawner without a saved age starts its delay now
+        spawner.RestoreState(SCR_ZombieLootTableManager.GetInstance().GetPrefab(prefabIndex), Math.Max(emptiedAge, 0));
+    }
+    
+    protected void ReadZombie()
+    {
+        float x = ReadFloat();
+        float y = ReadFloat();
+        float z = ReadFloat();
+        if (m_ZombieManager)
+            m_ZombieManager.RestoreZombie(Vector(x, y, z));
+    }
+    
+    protected void ReadPlayer()
+    {
+        SCR_ZombiePlayerSnapshot snapshot = new SCR_ZombiePlayerSnapshot();
+        snapshot.m_iIdentity = ReadInt();
+        snapshot.m_fHunger = ReadFloat();
+        snapshot.m_fThirst = ReadFloat();
+        snapshot.m_fInfection = ReadFloat();
+        m_mRestoredPlayers.Set(snapshot.m_iIdentity, snapshot);
+    }
+    
+    protected void FinishLoad()
+    {
+        m_ReadFile.Close();
+        m_ReadFile = null;
+        
+        // Players that spawned while the snapshot was still streaming in
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        array<int> playerIds = new array<int>();
+        playerManager.GetPlayers(playerIds);
+        foreach (int playerId : playerIds)
+        {
+            IEntity playerEntity = playerManager.GetPlayerControlledEntity(playerId);
+            if (playerEntity)
+                RestorePlayer(playerEntity);
+        }
+    }
+    
+    protected int GetPlayerIdentity(IEntity playerEntity)
+    {
+        int playerId = GetGame().GetPlayerManager().GetPlayerIdFromControlledEntity(playerEntity);
+        return GetGame().GetBackendApi().GetPlayerIdentityId(playerId).Hash();
+    }
+    
+    protected void WriteInt(int value)
+    {
+        m_WriteFile.Write(value, 4);
+    }
+    
+    protected void WriteFloat(float value)
+    {
+        m_WriteFile.Write(value, 4);
+    }
+    
+    protected int ReadInt()
+    {
+        int value;
+        m_ReadFile.Read(value, 4);
+        return value;
+    }
+    
+    protected float ReadFloat()
+    {
+        float value;
+        m_ReadFile.Read(value, 4);
+        return value;
+    }
+}
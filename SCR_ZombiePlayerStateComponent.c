@@ -0,0 +1,366 @@
+// Quantized survival and infection state of one player. Written by the server-side systems and
+// sent only to the owning client as one packed int, consumed there by the post-process compositor
+// and the HUD.
+class SCR_ZombiePlayerStateComponent : ScriptComponent
+{
+    static const int QUANTIZED_MAX = 255;
+    
+    // Crossing one of these bands, or any status effect change, bypasses the rate limit
+    static const int THRESHOLD_BAND = 51;
+    
+    static const float MIN_SEND_INTERVAL_MS = 2000;
+    
+    // Script cannot read per connection traffic, the bandwidth report is an estimate of the payload
+    // plus this rough per message cost
+    static const int RPC_OVERHEAD_BYTES = 8;
+    
+    // Set on the player prefab together with the component, clients read it from there
+    [Attribute("", UIWidgets.ResourceNamePicker, "Low cost cosmetic zombie rendered for far hordes, never simulated", "et")]
+    protected ResourceName m_ImpostorPrefab;
+    
+    protected int m_iHunger = QUANTIZED_MAX;
+    protected int m_iThirst = QUANTIZED_MAX;
+    protected int m_iInfection;
+    
+    // Bit per SCR_EZombieStatusEffect
+    protected int m_iEffectFlags;
+    
+    // Server side send bookkeeping
+    protected int m_iSentState = -1;
+    protected float m_fLastSendTime = -MIN_SEND_INTERVAL_MS;
+    protected int m_iPendingSendTimer;
+    protected int m_iEstimatedBytesSent;
+    protected int m_iMessagesSent;
+    protected float m_fStatsStartTime = -1;
+    protected int m_iSentHordeHash;
+    
+    // Horde summaries are counted apart so the state figures above stay comparable
+    protected int m_iHordeSummariesSent;
+    protected int m_iEstimatedHordeBytesSent;
+    
+    // Only exists on the machine controlling this player
+    protected ref SCR_ZombiePostProcessCompositor m_Compositor;
+    protected ref SCR_ZombieImpostorCrowd m_ImpostorCrowd;
+    protected ref ScriptInvoker m_OnStateChanged;
+    
+    // Rpc() needs the owner to replicate, which only holds for components on the player prefab
+    override void OnPostInit(IEntity owner)
+    {
+        super.OnPostInit(owner);
+        
+        if (!owner.FindComponent(RplComponent))
+            Print(string.Format("[Zombies] SCR_ZombiePlayerStateComponent on %1 without an RplComponent, state will not replicate", owner), LogLevel.ERROR);
+    }
+    
+    override void OnDelete(IEntity owner)
+    {
+        SCR_ZombieTimerWheel.CancelTimer(m_iPendingSendTimer);
+        
+        if (m_ImpostorCrowd)
+            m_ImpostorCrowd.Clear();
+            
+        // Every player has this component, zombie hits create effects with survival disabled too
+        SCR_ZombieStatusEffectManager effects = SCR_ZombieStatusEffectManager.FindInstance();
+        if (effects)
+            effects.ClearEffects(owner);
+            
+        SCR_ZombieConsumableExecutor executor = SCR_ZombieConsumableExecutor.FindInstance();
+        if (executor)
+            executor.ForgetUser(owner);
+            
+        super.OnDelete(owner);
+    }
+    
+    // Maps a 0-100 value onto a byte
+    static int Quantize(float value)
+    {
+        return Math.Round(Math.Clamp(value, 0, 100) * QUANTIZED_MAX / 100);
+    }
+    
+    static float Dequantize(int value)
+    {
+        return value * 100.0 / QUANTIZED_MAX;
+    }
+    
+    void SetSurvival(float hunger, float thirst)
+    {
+        int quantizedHunger = Quantize(hunger);
+        int quantizedThirst = Quantize(thirst);
+        if (quantizedHunger == m_iHunger && quantizedThirst == m_iThirst)
+            return;
+            
+        m_iHunger = quantizedHunger;
+        m_iThirst = quantizedThirst;
+        OnStateChanged();
+    }
+    
+    void SetInfection(float infection)
+    {
+        int quantizedInfection = Quantize(infection);
+        if (quantizedInfection == m_iInfection)
+            return;
+            
+        m_iInfection = quantizedInfection;
+        OnStateChanged();
+    }
+    
+    void SetEffectFlags(int flags)
+    {
+        if (flags == m_iEffectFlags)
+            return;
+            
+        m_iEffectFlags = flags;
+        OnStateChanged();
+    }
+    
+    float GetHunger()
+    {
+        return Dequantize(m_iHunger);
+    }
+    
+    float GetThirst()
+    {
+        return Dequantize(m_iThirst);
+    }
+    
+    float GetInfection()
+    {
+        return Dequantize(m_iInfection);
+    }
+    
+    bool HasEffect(SCR_EZombieStatusEffect type)
+    {
+        return (m_iEffectFlags & (1 << type)) != 0;
+    }
+    
+    // Client side hook for HUD elements, invoked with this component whenever new state arrives
+    ScriptInvoker GetOnStateChanged()
+    {
+        if (!m_OnStateChanged)
+            m_OnStateChanged = new ScriptInvoker();
+            
+        return m_OnStateChanged;
+    }
+    
+    // Shows a hint on the owning player's screen, wherever the calling code runs
+    static void ShowHint(IEntity player, string message, string tag, float duration)
+    {
+        if (!player)
+            return;
+            
+        SCR_ZombiePlayerStateComponent playerState = SCR_ZombiePlayerStateComponent.Cast(player.FindComponent(SCR_ZombiePlayerStateComponent));
+        if (playerState)
+        {
+            playerState.SendHint(message, tag, duration);
+            return;
+        }
+        
+        // No replicated state on this player, only the local machine can be reached
+        PlayerController playerController = GetGame().GetPlayerController();
+        if (playerController && playerController.GetControlledEntity() == player)
+            DisplayHint(message, tag, duration);
+    }
+    
+    // Far horde summary for the owning client's impostor crowd, resent only when it changed
+    void SendHordeSummary(notnull array<int> packedCells)
+    {
+        int hash = SCR_ZombieHordeSummary.Hash(packedCells);
+        if (hash == m_iSentHordeHash)
+            return;
+            
+        m_iSentHordeHash = hash;
+        
+        if (IsLocalPlayer())
+        {
+            ApplyHordeSummary(packedCells);
+            return;
+        }
+        
+        Rpc(RpcDo_SetHordeSummary, packedCells);
+        m_iHordeSummariesSent++;
+        m_iEstimatedHordeBytesSent += packedCells.Count() * 4 + RPC_OVERHEAD_BYTES;
+    }
+    
+    int GetEstimatedBytesSent()
+    {
+        return m_iEstimatedBytesSent;
+    }
+    
+    int GetMessagesSent()
+    {
+        return m_iMessagesSent;
+    }
+    
+    int GetHordeSummariesSent()
+    {
+        return m_iHordeSummariesSent;
+    }
+    
+    int GetEstimatedHordeBytesSent()
+    {
+        return m_iEstimatedHordeBytesSent;
+    }
+    
+    float GetEstimatedBytesPerSecond()
+    {
+        if (m_fStatsStartTime < 0)
+            return 0;
+            
+        float elapsed = (GetGame().GetWorld().GetWorldTime() - m_fStatsStartTime) / 1000;
+        if (elapsed <= 0)
+            return 0;
+            
+        return m_iEstimatedBytesSent / elapsed;
+    }
+    
+    protected void SendHint(string message, string tag, float duration)
+    {
+        if (IsLocalPlayer())
+        {
+            DisplayHint(message, tag, duration);
+            return;
+        }
+        
+        Rpc(RpcDo_ShowHint, message, tag, duration);
+        CountSent(message.Length() + tag.Length() + 4);
+    }
+    
+    protected void OnStateChanged()
+    {
+        if (IsLocalPlayer())
+            ApplyState();
+            
+        if (!Replication.IsServer())
+            return;
+            
+        int packedState = PackState();
+        if (packedState == m_iSentState)
+            return;
+            
+        float now = GetGame().GetWorld().GetWorldTime();
+        float sinceLastSend = now - m_fLastSendTime;
+        
+        if (sinceLastSend >= MIN_SEND_INTERVAL_MS || CrossesThreshold(packedState))
+        {
+            SendState();
+            return;
+        }
+        
+        // Within the rate limit, one deferred send carries whatever the state is by then
+        SCR_ZombieTimerWheel timers = SCR_ZombieTimerWheel.GetInstance();
+        if (!timers.IsScheduled(m_iPendingSendTimer))
+            m_iPendingSendTimer = timers.Schedule(SendState, MIN_SEND_INTERVAL_MS - sinceLastSend);
+    }
+    
+    protected void SendState(Managed context = null)
+    {
+        SCR_ZombieTimerWheel.GetInstance().Cancel(m_iPendingSendTimer);
+        
+        int packedState = PackState();
+        if (packedState == m_iSentState)
+            return;
+            
+        m_iSentState = packedState;
+        m_fLastSendTime = GetGame().GetWorld().GetWorldTime();
+        
+        // The listen server host already applied it locally
+        if (IsLocalPlayer())
+            return;
+            
+        Rpc(RpcDo_SetState, packedState);
+        CountSent(4);
+    }
+    
+    protected bool CrossesThreshold(int packedState)
+    {
+        if (m_iSentState == -1)
+            return true;
+            
+        for (int shift = 0; shift < 24; shift += 8)
+        {
+            int current = (packedState >> shift) & 0xFF;
+            int sent = (m_iSentState >> shift) & 0xFF;
+            if (current / THRESHOLD_BAND != sent / THRESHOLD_BAND)
+                return true;
+        }
+        
+        return (packedState >> 24) != (m_iSentState >> 24);
+    }
+    
+    protected int PackState()
+    {
+        return m_iHunger | (m_iThirst << 8) | (m_iInfection << 16) | (m_iEffectFlags << 24);
+    }
+    
+    protected void CountSent(int payloadBytes)
+    {
+        if (m_fStatsStartTime < 0)
+            m_fStatsStartTime = GetGame().GetWorld().GetWorldTime();
+            
+        m_iEstimatedBytesSent += payloadBytes + RPC_OVERHEAD_BYTES;
+        m_iMessagesSent++;
+    }
+    
+    [RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+    protected void RpcDo_SetState(int packedState)
+    {
+        m_iHunger = packedState & 0xFF;
+        m_iThirst = (packedState >> 8) & 0xFF;
+        m_iInfection = (packedState >> 16) & 0xFF;
+        m_iEffectFlags = (packedState >> 24) & 0xFF;
+        ApplyState();
+    }
+    
+    // Cosmetic only, a lost summary is replaced by the next one
+    [RplRpc(RplChannel.Unreliable, RplRcver.Owner)]
+    protected void RpcDo_SetHordeSummary(array<int> packedCells)
+    {
+        ApplyHordeSummary(packedCells);
+    }
+    
+    [RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+    protected void RpcDo_ShowHint(string message, string tag, float duration)
+    {
+        DisplayHint(message, tag, duration);
+    }
+    
+    protected static void DisplayHint(string message, string tag, float duration)
+    {
+        SCR_HintManagerComponent hintManager = SCR_HintManagerComponent.GetInstance();
+        if (hintManager)
+            hintManager.ShowCustomHint(message, tag, duration);
+    }
+    
+    protected void ApplyState()
+    {
+        if (!m_Compositor)
+            m_Compositor = new SCR_ZombiePostProcessCompositor(GetOwner());
+            
+        m_Compositor.Refresh(this);
+        
+        if (m_OnStateChanged)
+            m_OnStateChanged.Invoke(this);
+    }
+    
+    protected void ApplyHordeSummary(array<int> packedCells)
+    {
+        if (!packedCells)
+            return;
+            
+        if (!m_ImpostorCrowd)
+        {
+            if (m_ImpostorPrefab.IsEmpty())
+                Print("[Zombies] SCR_ZombiePlayerStateComponent has no impostor prefab, far hordes are not rendered", LogLevel.WARNING);
+                
+            m_ImpostorCrowd = new SCR_ZombieImpostorCrowd(m_ImpostorPrefab);
+        }
+            
+        m_ImpostorCrowd.Apply(packedCells);
+    }
+    
+    protected bool IsLocalPlayer()
+    {
+        PlayerController playerController = GetGame().GetPlayerController();
+        return playerController && playerController.GetControlledEntity() == GetOwner();
+    }
+}
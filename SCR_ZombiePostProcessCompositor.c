@@ -0,0 +1,209 @@
+enum SCR_EZombiePostProcessLayer
+{
+    STARVATION,
+    INFECTION,
+    PAIN_RELIEF
+}
+
+class SCR_ZombiePostProcessLayer
+{
+    bool m_bActive;
+    float m_fVignette;
+    ref Color m_VignetteColor = Color.FromRGBA(0, 0, 0, 0);
+    ref Color m_Tint = Color.FromRGBA(255, 255, 255, 255);
+    float m_fBlur;
+    float m_fDesaturation;
+    
+    // How strongly this layer pulls the blended tint back to neutral (0-1)
+    float m_fTintSuppression;
+    
+    void Reset()
+    {
+        m_bActive = false;
+        m_fVignette = 0;
+        m_VignetteColor = Color.FromRGBA(0, 0, 0, 0);
+        m_Tint = Color.FromRGBA(255, 255, 255, 255);
+        m_fBlur = 0;
+        m_fDesaturation = 0;
+        m_fTintSuppression = 0;
+    }
+}
+
+// Client-only owner of the local player's screen effects. Every system describes its look as a
+// layer; the layers are blended into one result and only values that differ from what was last
+// written reach SCR_PostProcessEffectsComponent.
+class SCR_ZombiePostProcessCompositor
+{
+    protected IEntity m_Owner;
+    protected SCR_PostProcessEffectsComponent m_PostProcess;
+    
+    protected ref array<ref SCR_ZombiePostProcessLayer> m_aLayers = new array<ref SCR_ZombiePostProcessLayer>();
+    
+    // Last applied values; -1 and a fully transparent color are never produced, forcing the first write
+    protected float m_fAppliedVignette = -1;
+    protected int m_iAppliedVignetteColor;
+    protected int m_iAppliedTint;
+    protected float m_fAppliedBlur = -1;
+    protected float m_fAppliedDesaturation = -1;
+    
+    protected int m_iWriteCount;
+    
+    void SCR_ZombiePostProcessCompositor(IEntity owner)
+    {
+        m_Owner = owner;
+        m_PostProcess = SCR_PostProcessEffectsComponent.Cast(owner.FindComponent(SCR_PostProcessEffectsComponent));
+        
+        // Indexed by SCR_EZombiePostProcessLayer
+        m_aLayers.Insert(new SCR_ZombiePostProcessLayer());
+        m_aLayers.Insert(new SCR_ZombiePostProcessLayer());
+        m_aLayers.Insert(new SCR_ZombiePostProcessLayer());
+    }
+    
+    void Refresh(SCR_ZombiePlayerStateComponent state)
+    {
+        UpdateStarvationLayer(state);
+        UpdateInfectionLayer(state);
+        UpdatePainReliefLayer(state);
+        Apply();
+    }
+    
+    int GetWriteCount()
+    {
+        return m_iWriteCount;
+    }
+    
+    protected void UpdateStarvationLayer(SCR_ZombiePlayerStateComponent state)
+    {
+        SCR_ZombiePostProcessLayer layer = m_aLayers[SCR_EZombiePostProcessLayer.STARVATION];
+        layer.Reset();
+        
+        if (!state.HasEffect(SCR_EZombieStatusEffect.STARVATION))
+            return;
+            
+        float hungerEffect = 1.0 - (state.GetHunger() / 100.0);
+        float thirstEffect = 1.0 - (state.GetThirst() / 100.0);
+        float combinedEffect = Math.Max(hungerEffect, thirstEffect);
+        
+        layer.m_bActive = true;
+        layer.m_fVignette = 0.3 * combinedEffect;
+        layer.m_fDesaturation = 0.4 * combinedEffect;
+    }
+    
+    protected void UpdateInfectionLayer(SCR_ZombiePlayerStateComponent state)
+    {
+        SCR_ZombiePostProcessLayer layer = m_aLayers[SCR_EZombiePostProcessLayer.INFECTION];
+        layer.Reset();
+        
+        if (state.HasEffect(SCR_EZombieStatusEffect.INFECTION_SEVERE))
+        {
+            layer.m_bActive = true;
+            layer.m_fVignette = 0.7;
+            layer.m_VignetteColor = Color.FromRGBA(150, 0, 0, 220);
+            layer.m_Tint = Color.FromRGBA(220, 100, 100, 255);
+            layer.m_fBlur = 0.2;
+        }
+        else if (state.HasEffect(SCR_EZombieStatusEffect.INFECTION_MODERATE))
+        {
+            layer.m_bActive = true;
+            layer.m_fVignette = 0.4;
+            layer.m_VignetteColor = Color.FromRGBA(128, 0, 0, 180);
+            layer.m_Tint = Color.FromRGBA(180, 130, 130, 255);
+        }
+        else if (state.HasEffect(SCR_EZombieStatusEffect.INFECTION_MILD))
+        {
+            layer.m_bActive = true;
+            layer.m_fVignette = 0.2;
+            layer.m_VignetteColor = Color.FromRGBA(128, 0, 0, 128);
+        }
+    }
+    
+    protected void UpdatePainReliefLayer(SCR_ZombiePlayerStateComponent state)
+    {
+        SCR_ZombiePostProcessLayer layer = m_aLayers[SCR_EZombiePostProcessLayer.PAIN_RELIEF];
+        layer.Reset();
+        
+        // Pain relief masks the red pain tint of the other layers
+        if (state.HasEffect(SCR_EZombieStatusEffect.PAIN_RELIEF))
+        {
+            layer.m_bActive = true;
+            layer.m_fTintSuppression = 1.0;
+        }
+    }
+    
+    protected void Apply()
+    {
+        if (!m_PostProcess)
+            return;
+            
+        float vignette = 0;
+        Color vignetteColor = Color.FromRGBA(0, 0, 0, 0);
+        float tintR = 1.0;
+        float tintG = 1.0;
+        float tintB = 1.0;
+        float blur = 0;
+        float desaturation = 0;
+        float tintSuppression = 0;
+        
+        foreach (SCR_ZombiePostProcessLayer layer : m_aLayers)
+        {
+            if (!layer.m_bActive)
+                continue;
+                
+            // Strongest vignette wins together with its color, tints multiply, the rest takes the maximum
+            if (layer.m_fVignette > vignette)
+            {
+                vignette = layer.m_fVignette;
+                vignetteColor = layer.m_VignetteColor;
+            }
+            
+            tintR *= layer.m_Tint.R();
+            tintG *= layer.m_Tint.G();
+            tintB *= layer.m_Tint.B();
+            blur = Math.Max(blur, layer.m_fBlur);
+            desaturation = Math.Max(desaturation, layer.m_fDesaturation);
+            tintSuppression = Math.Max(tintSuppression, layer.m_fTintSuppression);
+        }
+        
+        tintR = Math.Lerp(tintR, 1.0, tintSuppression);
+        tintG = Math.Lerp(tintG, 1.0, tintSuppression);
+        tintB = Math.Lerp(tintB, 1.0, tintSuppression);
+        Color tint = new Color(tintR, tintG, tintB, 1.0);
+        
+        if (vignette != m_fAppliedVignette)
+        {
+            m_PostProcess.SetVignetteIntensity(vignette);
+            m_fAppliedVignette = vignette;
+            m_iWriteCount++;
+        }
+        
+        int packedVignetteColor = vignetteColor.PackToInt();
+        if (vignette > 0 && packedVignetteColor != m_iAppliedVignetteColor)
+        {
+            m_PostProcess.SetVignetteColor(vignetteColor);
+            m_iAppliedVignetteColor = packedVignetteColor;
+            m_iWriteCount++;
+        }
+        
+        int packedTint = tint.PackToInt();
+        if (packedTint != m_iAppliedTint)
+        {
+            m_PostProcess.SetColorGradingTint(tint);
+            m_iAppliedTint = packedTint;
+            m_iWriteCount++;
+        }
+        
+        if (blur != m_fAppliedBlur)
+        {
+            m_PostProcess.SetBlurIntensity(blur);
+            m_fAppliedBlur = blur;
+            m_iWriteCount++;
+        }
+        
+        if (desaturation != m_fAppliedDesaturation)
+        {
+            m_PostProcess.SetDesaturation(desaturation);
+            m_fAppliedDesaturation = desaturation;
+            m_iWriteCount++;
+        }
+    }
+}
@@ -0,0 +1,159 @@
+// Players close enough to share one zombie pool
+class SCR_ZombiePlayerCluster
+{
+    ref array<IEntity> m_aPlayers = new array<IEntity>();
+    vector m_vCenter;
+    float m_fBudget;
+    int m_iNearCount;
+    float m_fDeficit;
+    int m_iNextPlayer;
+}
+
+// Distributes spawns between players. Players chained together by the cluster radius form one
+// cluster (connected components over the pairwise distances),
+// a cluster's budget grows sublinearly with its size so a group does not draw the sum of its
+// members' budgets. Zombies near a cluster are counted from the relevancy grid with an exact
+// distance test, and each spawn goes to the cluster with the largest remaining deficit.
+class SCR_ZombieQuotaAllocator
+{
+    // Budget of a cluster of n players is perPlayer * n^BUDGET_EXPONENT
+    static const float BUDGET_EXPONENT = 0.7;
+    
+    protected ref array<ref SCR_ZombiePlayerCluster> m_aClusters = new array<ref SCR_ZombiePlayerCluster>();
+    
+    // Per pass scratch, union-find over the live players
+    protected ref array<IEntity> m_aPlayers = new array<IEntity>();
+    protected ref array<int> m_aParents = new array<int>();
+    protected ref array<int> m_aRootClusters = new array<int>();
+    protected float m_fTotalBudget;
+    protected int m_iAllocatedCount;
+    
+    // Rebuilds clusters and deficits for the current players
+    void Update(notnull array<IEntity> players, int perPlayerBudget, float clusterRadius, float countRadius)
+    {
+        m_aClusters.Clear();
+        m_fTotalBudget = 0;
+        float clusterRadiusSq = clusterRadius * clusterRadius;
+        
+        m_aPlayers.Clear();
+        m_aParents.Clear();
+        foreach (IEntity player : players)
+        {
+            if (player)
+                m_aParents.Insert(m_aPlayers.Insert(player));
+        }
+        
+        // Every close pair is joined, so a player bridging two groups merges them; player counts are
+        // small enough for the pairwise pass
+        int playerCount = m_aPlayers.Count();
+        for (int first = 0; first < playerCount; first++)
+        {
+            vector position = m_aPlayers[first].GetOrigin();
+            for (int second = first + 1; second < playerCount; second++)
+            {
+                if (vector.DistanceSqXZ(m_aPlayers[second].GetOrigin(), position) <= clusterRadiusSq)
+                    m_aParents[FindRoot(first)] = FindRoot(second);
+            }
+        }
+        
+        m_aRootClusters.Clear();
+        for (int slot = 0; slot < playerCount; slot++)
+        {
+            m_aRootClusters.Insert(-1);
+        }
+        
+        for (int member = 0; member < playerCount; member++)
+        {
+            int root = FindRoot(member);
+            if (m_aRootClusters[root] == -1)
+                m_aRootClusters[root] = m_aClusters.Insert(new SCR_ZombiePlayerCluster());
+                
+            m_aClusters[m_aRootClusters[root]].m_aPlayers.Insert(m_aPlayers[member]);
+        }
+        
+        SCR_ZombieNetRelevancy relevancy = SCR_ZombieNetRelevancy.GetInstance();
+        foreach (SCR_ZombiePlayerCluster counted : m_aClusters)
+        {
+            // The count circle covers every member, so overlapping members are not counted twice
+            vector center = vector.Zero;
+            foreach (IEntity centerMember : counted.m_aPlayers)
+            {
+                center = center + centerMember.GetOrigin();
+            }
+            
+            float memberCount = counted.m_aPlayers.Count();
+            center = center / memberCount;
+            
+            float spread = 0;
+            foreach (IEntity spreadMember : counted.m_aPlayers)
+            {
+                spread = Math.Max(spread, vector.DistanceXZ(spreadMember.GetOrigin(), center));
+            }
+            
+            counted.m_vCenter = center;
+            counted.m_fBudget = perPlayerBudget * Math.Pow(memberCount, BUDGET_EXPONENT);
+            counted.m_iNearCount = relevancy.CountNear(center, countRadius + spread);
+            counted.m_fDeficit = counted.m_fBudget - counted.m_iNearCount;
+            m_fTotalBudget += counted.m_fBudget;
+        }
+    }
+    
+    // Member of the cluster with the largest deficit, members take turns; null when every cluster
+    // is at its budget
+    IEntity Next()
+    {
+        SCR_ZombiePlayerCluster best;
+        foreach (SCR_ZombiePlayerCluster cluster : m_aClusters)
+        {
+            if (cluster.m_fDeficit >= 1 && (!best || cluster.m_fDeficit > best.m_fDeficit))
+                best = cluster;
+        }
+        
+        if (!best)
+            return null;
+            
+        best.m_fDeficit = best.m_fDeficit - 1;
+        best.m_iNextPlayer = (best.m_iNextPlayer + 1) % best.m_aPlayers.Count();
+        m_iAllocatedCount++;
+        return best.m_aPlayers[best.m_iNextPlayer];
+    }
+    
+    protected int FindRoot(int index)
+    {
+        while (m_aParents[index] != index)
+        {
+            // Path halving keeps the chains short
+            m_aParents[index] = m_aParents[m_aParents[index]];
+            index = m_aParents[index];
+        }
+        
+        return index;
+    }
+    
+    int GetClusterCount()
+    {
+        return m_aClusters.Count();
+    }
+    
+    float GetTotalBudget()
+    {
+        return m_fTotalBudget;
+    }
+    
+    int GetAllocatedCount()
+    {
+        return m_iAllocatedCount;
+    }
+    
+    // Largest remaining deficit over all clusters, 0 when every cluster is at its budget
+    float GetLargestDeficit()
+    {
+        float largest = 0;
+        foreach (SCR_ZombiePlayerCluster cluster : m_aClusters)
+        {
+            largest = Math.Max(largest, cluster.m_fDeficit);
+        }
+        
+        return largest;
+    }
+}
@@ -0,0 +1,117 @@
+// Uniform grid over the XZ plane. Items are bucketed by cell so range queries only visit the
+// cells overlapping the query circle; callers do the exact distance test on the returned items.
+class SCR_ZombieSpatialGrid
+{
+    // Cell coordinates are packed into one int key, 16 bits per axis
+    static const int CELL_OFFSET = 32768;
+    
+    protected float m_fCellSize;
+    protected ref map<int, ref array<Managed>> m_mCells = new map<int, ref array<Managed>>();
+    protected int m_iCount;
+    
+    void SCR_ZombieSpatialGrid(float cellSize)
+    {
+        m_fCellSize = Math.Max(cellSize, 1);
+    }
+    
+    float GetCellSize()
+    {
+        return m_fCellSize;
+    }
+    
+    int GetCount()
+    {
+        return m_iCount;
+    }
+    
+    int GetCellKey(vector position)
+    {
+        return MakeKey(Math.Floor(position[0] / m_fCellSize), Math.Floor(position[2] / m_fCellSize));
+    }
+    
+    // Returns the cell key, which the caller keeps for Remove and Move
+    int Insert(Managed item, vector position)
+    {
+        int key = GetCellKey(position);
+        array<Managed> cell = m_mCells.Get(key);
+        if (!cell)
+        {
+            cell = new array<Managed>();
+            m_mCells.Insert(key, cell);
+        }
+        
+        cell.Insert(item);
+        m_iCount++;
+        return key;
+    }
+    
+    void Remove(Managed item, int key)
+    {
+        array<Managed> cell = m_mCells.Get(key);
+        if (!cell)
+            return;
+            
+        int index = cell.Find(item);
+        if (index == -1)
+            return;
+            
+        cell.Remove(index);
+        m_iCount--;
+        
+        if (cell.IsEmpty())
+            m_mCells.Remove(key);
+    }
+    
+    // Rebuckets the item only when it crossed a cell border, returns the new key
+    int Move(Managed item, int key, vector position)
+    {
+        int newKey = GetCellKey(position);
+        if (newKey == key)
+            return key;
+            
+        Remove(item, key);
+        return Insert(item, position);
+    }
+    
+    // Appends every item from the cells overlapping the circle, returns the number appended
+    int Query(vector center, float radius, notnull array<Managed> outItems)
+    {
+        int minX = Math.Floor((center[0] - radius) / m_fCellSize);
+        int maxX = Math.Floor((center[0] + radius) / m_fCellSize);
+        int minZ = Math.Floor((center[2] - radius) / m_fCellSize);
+        int maxZ = Math.Floor((center[2] + radius) / m_fCellSize);
+        
+        int found = 0;
+        for (int x = minX; x <= maxX; x++)
+        {
+            for (int z = minZ; z <= maxZ; z++)
+            {
+                array<Managed> cell = m_mCells.Get(MakeKey(x, z));
+                if (!cell)
+                    continue;
+                    
+                foreach (Managed item : cell)
+                {
+                    if (!item)
+                        continue;
+                        
+                    outItems.Insert(item);
+                    found++;
+                }
+            }
+        }
+        
+        return found;
+    }
+    
+    void Clear()
+    {
+        m_mCells.Clear();
+        m_iCount = 0;
+    }
+    
+    protected int MakeKey(int cellX, int cellZ)
+    {
+        return (((cellX + CELL_OFFSET) & 0xFFFF) << 16) | ((cellZ + CELL_OFFSET) & 0xFFFF);
+    }
+}
@@ -0,0 +1,250 @@
+enum SCR_EZombieStat
+{
+    SPEED,
+    STAMINA,
+    DAMAGE_TAKEN
+}
+
+// Multiplicative modifiers registered on one player by independent sources
+class SCR_ZombieStatModifierStack
+{
+    IEntity m_Owner;
+    
+    ref array<int> m_aSources = new array<int>();
+    ref array<int> m_aStats = new array<int>();
+    ref array<float> m_aValues = new array<float>();
+    
+    // Derived values per SCR_EZombieStat, valid while not dirty
+    ref array<float> m_aDerived = {1.0, 1.0, 1.0};
+    
+    // Last values written to the engine so unchanged stats are never pushed again
+    float m_fPushedSpeed = 1.0;
+    float m_fPushedStamina = 1.0;
+    float m_fBaseMaxStamina = -1;
+    
+    bool m_bDirty;
+    
+    int Find(int source, SCR_EZombieStat stat)
+    {
+        for (int i = 0; i < m_aSources.Count(); i++)
+        {
+            if (m_aSources[i] == source && m_aStats[i] == stat)
+                return i;
+        }
+        
+        return -1;
+    }
+    
+    void Recompute()
+    {
+        for (int stat = 0; stat < m_aDerived.Count(); stat++)
+        {
+            m_aDerived[stat] = 1.0;
+        }
+        
+        for (int i = 0; i < m_aValues.Count(); i++)
+        {
+            m_aDerived[m_aStats[i]] = m_aDerived[m_aStats[i]] * m_aValues[i];
+        }
+        
+        m_bDirty = false;
+    }
+}
+
+// Single owner of derived movement and stamina values. Sources only register modifiers;
+// dirty stacks are recomputed in one coalesced pass and pushed to the character controller once.
+class SCR_ZombieStatModifierManager
+{
+    // Status effects register under their SCR_EZombieStatusEffect value, other sources start here
+    static const int SOURCE_CONSUMABLE = 100;
+    
+    protected static ref SCR_ZombieStatModifierManager s_Instance;
+    
+    protected ref map<IEntity, ref SCR_ZombieStatModifierStack> m_mStacks = new map<IEntity, ref SCR_ZombieStatModifierStack>();
+    protected ref array<SCR_ZombieStatModifierStack> m_aDirtyStacks = new array<SCR_ZombieStatModifierStack>();
+    
+    protected int m_iFlushTimer;
+    protected int m_iEnginePushCount;
+    
+    static SCR_ZombieStatModifierManager GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieStatModifierManager();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieStatModifierManager FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        if (!s_Instance)
+            return;
+            
+        SCR_ZombieTimerWheel.CancelTimer(s_Instance.m_iFlushTimer);
+        s_Instance = null;
+    }
+    
+    void SetModifier(IEntity player, int source, SCR_EZombieStat stat, float value)
+    {
+        if (!player)
+            return;
+            
+        SCR_ZombieStatModifierStack stack = m_mStacks.Get(player);
+        if (!stack)
+        {
+            stack = new SCR_ZombieStatModifierStack();
+            stack.m_Owner = player;
+            m_mStacks.Insert(player, stack);
+        }
+        
+        int index = stack.Find(source, stat);
+        if (index == -1)
+        {
+            stack.m_aSources.Insert(source);
+            stack.m_aStats.Insert(stat);
+            stack.m_aValues.Insert(value);
+        }
+        else
+        {
+            if (stack.m_aValues[index] == value)
+                return;
+                
+            stack.m_aValues[index] = value;
+        }
+        
+        MarkDirty(stack);
+    }
+    
+    void RemoveModifier(IEntity player, int source, SCR_EZombieStat stat)
+    {
+        SCR_ZombieStatModifierStack stack = m_mStacks.Get(player);
+        if (!stack)
+            return;
+            
+        int index = stack.Find(source, stat);
+        if (index == -1)
+            return;
+            
+        RemoveAt(stack, index);
+        MarkDirty(stack);
+    }
+    
+    void RemoveSource(IEntity player, int source)
+    {
+        SCR_ZombieStatModifierStack stack = m_mStacks.Get(player);
+        if (!stack)
+            return;
+            
+        bool removed = false;
+        for (int i = stack.m_aSources.Count() - 1; i >= 0; i--)
+        {
+            if (stack.m_aSources[i] != source)
+                continue;
+                
+            RemoveAt(stack, i);
+            removed = true;
+        }
+        
+        if (removed)
+            MarkDirty(stack);
+    }
+    
+    void ClearModifiers(IEntity player)
+    {
+        m_mStacks.Remove(player);
+    }
+    
+    float GetValue(IEntity player, SCR_EZombieStat stat)
+    {
+        SCR_ZombieStatModifierStack stack = m_mStacks.Get(player);
+        if (!stack)
+            return 1.0;
+            
+        if (stack.m_bDirty)
+            stack.Recompute();
+            
+        return stack.m_aDerived[stat];
+    }
+    
+    int GetEnginePushCount()
+    {
+        return m_iEnginePushCount;
+    }
+    
+    protected void RemoveAt(SCR_ZombieStatModifierStack stack, int index)
+    {
+        stack.m_aSources.Remove(index);
+        stack.m_aStats.Remove(index);
+        stack.m_aValues.Remove(index);
+    }
+    
+    protected void MarkDirty(SCR_ZombieStatModifierStack stack)
+    {
+        if (!stack.m_bDirty)
+        {
+            stack.m_bDirty = true;
+            m_aDirtyStacks.Insert(stack);
+        }
+        
+        // Any number of changes within the same tick collapse into one flush
+        m_iFlushTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(FlushDirtyStacks, 0, false, null, true);
+    }
+    
+    protected void FlushDirtyStacks(Managed context = null)
+    {
+        foreach (SCR_ZombieStatModifierStack stack : m_aDirtyStacks)
+        {
+            if (!stack)
+                continue;
+                
+            // GetValue may already have recomputed it, the engine push is still pending
+            if (stack.m_bDirty)
+                stack.Recompute();
+                
+            PushToCharacter(stack);
+        }
+        
+        m_aDirtyStacks.Clear();
+    }
+    
+    protected void PushToCharacter(SCR_ZombieStatModifierStack stack)
+    {
+        if (!stack.m_Owner)
+            return;
+            
+        float speed = stack.m_aDerived[SCR_EZombieStat.SPEED];
+        float stamina = stack.m_aDerived[SCR_EZombieStat.STAMINA];
+        if (speed == stack.m_fPushedSpeed && stamina == stack.m_fPushedStamina)
+            return;
+            
+        SCR_CharacterControllerComponent controller = SCR_CharacterControllerComponent.Cast(stack.m_Owner.FindComponent(SCR_CharacterControllerComponent));
+        if (!controller)
+            return;
+            
+        if (speed != stack.m_fPushedSpeed)
+        {
+            controller.SetSpeedMultiplier(speed);
+            stack.m_fPushedSpeed = speed;
+            m_iEnginePushCount++;
+        }
+        
+        if (stamina != stack.m_fPushedStamina)
+        {
+            // Always scale from the unmodified maximum so penalties never compound
+            if (stack.m_fBaseMaxStamina < 0)
+            {
+                controller.ResetMaxStamina();
+                stack.m_fBaseMaxStamina = controller.GetMaxStamina();
+            }
+            
+            controller.SetMaxStamina(stack.m_fBaseMaxStamina * stamina);
+            stack.m_fPushedStamina = stamina;
+            m_iEnginePushCount++;
+        }
+    }
+}
@@ -0,0 +1,393 @@
+enum SCR_EZombieStatusEffect
+{
+    PAIN_RELIEF,
+    BLEEDING,
+    INFECTION_MILD,
+    INFECTION_MODERATE,
+    INFECTION_SEVERE,
+    STARVATION
+}
+
+class SCR_ZombieStatusEffectDefinition
+{
+    float m_fSpeedMultiplier;
+    float m_fStaminaMultiplier;
+    float m_fDamageTakenMultiplier;
+    
+    // Damage per second scaled by the effect magnitude, 0 for effects without a periodic part
+    float m_fDamagePerSecond;
+    
+    void SCR_ZombieStatusEffectDefinition(float speedMultiplier, float staminaMultiplier, float damageTakenMultiplier, float damagePerSecond)
+    {
+        m_fSpeedMultiplier = speedMultiplier;
+        m_fStaminaMultiplier = staminaMultiplier;
+        m_fDamageTakenMultiplier = damageTakenMultiplier;
+        m_fDamagePerSecond = damagePerSecond;
+    }
+}
+
+// Active effects of one player, kept as a handful of parallel entries rather than components or timers
+class SCR_ZombieStatusEffectTable
+{
+    IEntity m_Owner;
+    
+    ref array<int> m_aTypes = new array<int>();
+    ref array<float> m_aMagnitudes = new array<float>();
+    
+    // World time in ms, 0 for effects that last until removed
+    ref array<float> m_aExpiryTimes = new array<float>();
+    ref array<int> m_aSerials = new array<int>();
+    
+    bool m_bHasPeriodicEffects;
+    
+    int Find(SCR_EZombieStatusEffect type)
+    {
+        return m_aTypes.Find(type);
+    }
+    
+    void RemoveAt(int index)
+    {
+        m_aTypes.Remove(index);
+        m_aMagnitudes.Remove(index);
+        m_aExpiryTimes.Remove(index);
+        m_aSerials.Remove(index);
+    }
+}
+
+// Owns every player status effect. Timed effects expire through a single global min-heap
+// that keeps exactly one wheel timer armed for the earliest expiry; stale heap entries are
+// skipped by serial instead of being searched for and removed. Modifiers are registered with
+// SCR_ZombieStatModifierManager rather than written to the character directly.
+class SCR_ZombieStatusEffectManager
+{
+    static const float PERIODIC_INTERVAL_MS = 1000;
+    
+    protected static ref SCR_ZombieStatusEffectManager s_Instance;
+    
+    protected ref array<ref SCR_ZombieStatusEffectDefinition> m_aDefinitions = new array<ref SCR_ZombieStatusEffectDefinition>();
+    protected ref map<IEntity, ref SCR_ZombieStatusEffectTable> m_mTables = new map<IEntity, ref SCR_ZombieStatusEffectTable>();
+    
+    // Min-heap on expiry time
+    protected ref array<float> m_aHeapTimes = new array<float>();
+    protected ref array<SCR_ZombieStatusEffectTable> m_aHeapTables = new array<SCR_ZombieStatusEffectTable>();
+    protected ref array<int> m_aHeapSerials = new array<int>();
+    
+    protected int m_iNextSerial = 1;
+    protected int m_iExpiryTimer;
+    protected float m_fArmedExpiryTime;
+    protected int m_iPeriodicTimer;
+    
+    static SCR_ZombieStatusEffectManager GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_ZombieStatusEffectManager();
+            
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring the instance back
+    static SCR_ZombieStatusEffectManager FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    static void Shutdown()
+    {
+        if (!s_Instance)
+            return;
+            
+        SCR_ZombieTimerWheel.CancelTimer(s_Instance.m_iExpiryTimer);
+        SCR_ZombieTimerWheel.CancelTimer(s_Instance.m_iPeriodicTimer);
+        s_Instance = null;
+    }
+    
+    void SCR_ZombieStatusEffectManager()
+    {
+        // Indexed by SCR_EZombieStatusEffect
+        m_aDefinitions.Insert(new SCR_ZombieStatusEffectDefinition(1.1, 1.0, 0.9, 0));  // PAIN_RELIEF
+        m_aDefinitions.Insert(new SCR_ZombieStatusEffectDefinition(1.0, 1.0, 1.0, 1.0));  // BLEEDING
+        m_aDefinitions.Insert(new SCR_ZombieStatusEffectDefinition(1.0, 0.9, 1.0, 0));  // INFECTION_MILD
+        m_aDefinitions.Insert(new SCR_ZombieStatusEffectDefinition(1.0, 0.7, 1.0, 0));  // INFECTION_MODERATE
+        m_aDefinitions.Insert(new SCR_ZombieStatusEffectDefinition(1.0, 0.5, 1.0, 0));  // INFECTION_SEVERE
+        m_aDefinitions.Insert(new SCR_ZombieStatusEffectDefinition(1.0, 1.0, 1.0, 0));  // STARVATION
+        
+        m_iPeriodicTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(ApplyPeriodicEffects, PERIODIC_INTERVAL_MS, true);
+    }
+    
+    // Duration in seconds, 0 keeps the effect until RemoveEffect. Re-applying keeps the later expiry.
+    void AddEffect(IEntity player, SCR_EZombieStatusEffect type, float duration = 0, float magnitude = 1.0)
+    {
+        if (!player)
+            return;
+            
+        SCR_ZombieStatusEffectTable table = GetOrCreateTable(player);
+        float expiryTime = 0;
+        if (duration > 0)
+            expiryTime = GetGame().GetWorld().GetWorldTime() + duration * 1000;
+            
+        bool expiryChanged = true;
+        int index = table.Find(type);
+        if (index == -1)
+        {
+            index = table.m_aTypes.Insert(type);
+            table.m_aMagnitudes.Insert(magnitude);
+            table.m_aExpiryTimes.Insert(expiryTime);
+            table.m_aSerials.Insert(0);
+            
+            RegisterModifiers(player, type);
+        }
+        else
+        {
+            table.m_aMagnitudes[index] = Math.Max(table.m_aMagnitudes[index], magnitude);
+            
+            float currentExpiry = table.m_aExpiryTimes[index];
+            if (currentExpiry == 0 || (expiryTime != 0 && expiryTime <= currentExpiry))
+                expiryTime = currentExpiry;
+                
+            expiryChanged = expiryTime != currentExpiry;
+            table.m_aExpiryTimes[index] = expiryTime;
+        }
+        
+        // A changed expiry invalidates the old heap entry, a permanent effect has none
+        if (expiryChanged)
+        {
+            int serial = 0;
+            if (expiryTime > 0)
+            {
+                serial = m_iNextSerial++;
+                HeapPush(expiryTime, table, serial);
+            }
+            
+            table.m_aSerials[index] = serial;
+        }
+        
+        OnEffectsChanged(table);
+    }
+    
+    void RemoveEffect(IEntity player, SCR_EZombieStatusEffect type)
+    {
+        SCR_ZombieStatusEffectTable table = m_mTables.Get(player);
+        if (!table)
+            return;
+            
+        int index = table.Find(type);
+        if (index == -1)
+            return;
+            
+        table.RemoveAt(index);
+        SCR_ZombieStatModifierManager.GetInstance().RemoveSource(player, type);
+        OnEffectsChanged(table);
+    }
+    
+    void ClearEffects(IEntity player)
+    {
+        m_mTables.Remove(player);
+        SCR_ZombieStatModifierManager modifiers = SCR_ZombieStatModifierManager.FindInstance();
+        if (modifiers)
+            modifiers.ClearModifiers(player);
+    }
+    
+    bool HasEffect(IEntity player, SCR_EZombieStatusEffect type)
+    {
+        SCR_ZombieStatusEffectTable table = m_mTables.Get(player);
+        return table && table.Find(type) != -1;
+    }
+    
+    // Remaining seconds, 0 when the effect is absent or has no expiry
+    float GetRemainingTime(IEntity player, SCR_EZombieStatusEffect type)
+    {
+        SCR_ZombieStatusEffectTable table = m_mTables.Get(player);
+        if (!table)
+            return 0;
+            
+        int index = table.Find(type);
+        if (index == -1 || table.m_aExpiryTimes[index] == 0)
+            return 0;
+            
+        return Math.Max(0, table.m_aExpiryTimes[index] - GetGame().GetWorld().GetWorldTime()) / 1000;
+    }
+    
+    protected SCR_ZombieStatusEffectTable GetOrCreateTable(IEntity player)
+    {
+        SCR_ZombieStatusEffectTable table = m_mTables.Get(player);
+        if (!table)
+        {
+            table = new SCR_ZombieStatusEffectTable();
+            table.m_Owner = player;
+            m_mTables.Insert(player, table);
+        }
+        
+        return table;
+    }
+    
+    // Each effect is its own modifier source, the modifier manager combines and pushes them
+    protected void RegisterModifiers(IEntity player, SCR_EZombieStatusEffect type)
+    {
+        SCR_ZombieStatusEffectDefinition definition = m_aDefinitions[type];
+        SCR_ZombieStatModifierManager modifiers = SCR_ZombieStatModifierManager.GetInstance();
+        
+        if (definition.m_fSpeedMultiplier != 1.0)
+            modifiers.SetModifier(player, type, SCR_EZombieStat.SPEED, definition.m_fSpeedMultiplier);
+            
+        if (definition.m_fStaminaMultiplier != 1.0)
+            modifiers.SetModifier(player, type, SCR_EZombieStat.STAMINA, definition.m_fStaminaMultiplier);
+            
+        if (definition.m_fDamageTakenMultiplier != 1.0)
+            modifiers.SetModifier(player, type, SCR_EZombieStat.DAMAGE_TAKEN, definition.m_fDamageTakenMultiplier);
+    }
+    
+    protected void OnEffectsChanged(SCR_ZombieStatusEffectTable table)
+    {
+        bool periodic = false;
+        int flags = 0;
+        foreach (int type : table.m_aTypes)
+        {
+            flags |= 1 << type;
+            
+            if (m_aDefinitions[type].m_fDamagePerSecond > 0)
+                periodic = true;
+        }
+        
+        table.m_bHasPeriodicEffects = periodic;
+        
+        // Active effects reach the owning client as a bit mask for its visual effects
+        if (!table.m_Owner)
+            return;
+            
+        SCR_ZombiePlayerStateComponent playerState = SCR_ZombiePlayerStateComponent.Cast(table.m_Owner.FindComponent(SCR_ZombiePlayerStateComponent));
+        if (playerState)
+            playerState.SetEffectFlags(flags);
+    }
+    
+    protected void ProcessExpiries(Managed context = null)
+    {
+        m_iExpiryTimer = 0;
+        m_fArmedExpiryTime = 0;
+        
+        float now = GetGame().GetWorld().GetWorldTime();
+        while (!m_aHeapTimes.IsEmpty() && m_aHeapTimes[0] <= now)
+        {
+            SCR_ZombieStatusEffectTable table = m_aHeapTables[0];
+            int serial = m_aHeapSerials[0];
+            HeapPop();
+            
+            // Entries of removed, refreshed or cleared effects are simply dropped here
+            if (!table)
+                continue;
+                
+            int index = table.m_aSerials.Find(serial);
+            if (index == -1)
+                continue;
+                
+            SCR_ZombieStatModifierManager.GetInstance().RemoveSource(table.m_Owner, table.m_aTypes[index]);
+            table.RemoveAt(index);
+            OnEffectsChanged(table);
+        }
+        
+        ArmExpiryTimer();
+    }
+    
+    protected void ApplyPeriodicEffects(Managed context = null)
+    {
+        float seconds = PERIODIC_INTERVAL_MS / 1000;
+        
+        foreach (IEntity player, SCR_ZombieStatusEffectTable table : m_mTables)
+        {
+            if (!table.m_bHasPeriodicEffects || !player)
+                continue;
+                
+            float damage = 0;
+            for (int i = 0; i < table.m_aTypes.Count(); i++)
+            {
+                damage += m_aDefinitions[table.m_aTypes[i]].m_fDamagePerSecond * table.m_aMagnitudes[i] * seconds;
+            }
+            
+            if (damage <= 0)
+                continue;
+                
+            DamageManagerComponent dmgMgr = DamageManagerComponent.Cast(player.FindComponent(DamageManagerComponent));
+            if (dmgMgr)
+            {
+                DamageParams params = new DamageParams();
+                params.Damage = damage;
+                params.DamageType = EDamageType.BLEEDING;
+                
+                dmgMgr.InflictDamage(params);
+            }
+        }
+    }
+    
+    // Keeps exactly one wheel entry armed at the earliest pending expiry
+    protected void ArmExpiryTimer()
+    {
+        if (m_aHeapTimes.IsEmpty())
+            return;
+            
+        float earliest = m_aHeapTimes[0];
+        if (m_iExpiryTimer && m_fArmedExpiryTime <= earliest)
+            return;
+            
+        SCR_ZombieTimerWheel timers = SCR_ZombieTimerWheel.GetInstance();
+        timers.Cancel(m_iExpiryTimer);
+        
+        float delay = Math.Max(0, earliest - GetGame().GetWorld().GetWorldTime());
+        m_iExpiryTimer = timers.Schedule(ProcessExpiries, delay);
+        m_fArmedExpiryTime = earliest;
+    }
+    
+    protected void HeapPush(float time, SCR_ZombieStatusEffectTable table, int serial)
+    {
+        int index = m_aHeapTimes.Insert(time);
+        m_aHeapTables.Insert(table);
+        m_aHeapSerials.Insert(serial);
+        
+        while (index > 0)
+        {
+            int parent = (index - 1) / 2;
+            if (m_aHeapTimes[parent] <= m_aHeapTimes[index])
+                break;
+                
+            HeapSwap(index, parent);
+            index = parent;
+        }
+        
+        ArmExpiryTimer();
+    }
+    
+    protected void HeapPop()
+    {
+        int last = m_aHeapTimes.Count() - 1;
+        HeapSwap(0, last);
+        m_aHeapTimes.Remove(last);
+        m_aHeapTables.Remove(last);
+        m_aHeapSerials.Remove(last);
+        
+        int count = m_aHeapTimes.Count();
+        int index = 0;
+        while (true)
+        {
+            int smallest = index;
+            int left = index * 2 + 1;
+            int right = left + 1;
+            
+            if (left < count && m_aHeapTimes[left] < m_aHeapTimes[smallest])
+                smallest = left;
+                
+            if (right < count && m_aHeapTimes[right] < m_aHeapTimes[smallest])
+                smallest = right;
+                
+            if (smallest == index)
+                break;
+                
+            HeapSwap(index, smallest);
+            index = smallest;
+        }
+    }
+    
+    protected void HeapSwap(int a, int b)
+    {
+        m_aHeapTimes.SwapItems(a, b);
+        m_aHeapTables.SwapItems(a, b);
+        m_aHeapSerials.SwapItems(a, b);
+    }
+}
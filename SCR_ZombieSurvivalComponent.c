@@ -24,25 +24,30 @@ class SCR_ZombieSurvivalComponent : ScriptComponent
     [Attribute("60.0", UIWidgets.Auto, "Interval in seconds between starvation damage")]
     protected float m_fStarvationDamageInterval;
     
+    protected int m_iUpdateTimer;
+    protected int m_iStarvationTimer;
+    protected SCR_ZombiePlayerStateComponent m_PlayerState;
+    
     override void OnPostInit(IEntity owner)
     {
         super.OnPostInit(owner);
         
         if (owner.FindComponent(SCR_CharacterControllerComponent))
         {
-            GetGame().GetCallqueue().CallLater(UpdateSurvival, 1000, true);
-            GetGame().GetCallqueue().CallLater(ApplyStarvationEffects, m_fStarvationDamageInterval * 1000, true);
+            SCR_ZombieTimerWheel timers = SCR_ZombieTimerWheel.GetInstance();
+            m_iUpdateTimer = timers.Schedule(UpdateSurvival, 1000, true);
+            m_iStarvationTimer = timers.Schedule(ApplyStarvationEffects, m_fStarvationDamageInterval * 1000, true);
         }
     }
     
     override void OnDelete(IEntity owner)
     {
-        GetGame().GetCallqueue().Remove(UpdateSurvival);
-        GetGame().GetCallqueue().Remove(ApplyStarvationEffects);
+        SCR_ZombieTimerWheel.CancelTimer(m_iUpdateTimer);
+        SCR_ZombieTimerWheel.CancelTimer(m_iStarvationTimer);
         super.OnDelete(owner);
     }
     
-    void UpdateSurvival()
+    void UpdateSurvival(Managed context = null)
     {
         // Decrease hunger and thirst over time
         m_fHunger -= m_fHungerDecreaseRate;
@@ -55,14 +60,18 @@ class SCR_ZombieSurvivalComponent : ScriptComponent
         if (m_fThirst < 0)
             m_fThirst = 0;
             
-        // Update UI if needed
-        UpdateSurvivalUI();
+        // The owning client's HUD and screen effects update from this replicated state
+        ReplicateState();
     }
     
-    void ApplyStarvationEffects()
+    void ApplyStarvationEffects(Managed context = null)
     {
+        SCR_ZombieStatusEffectManager effects = SCR_ZombieStatusEffectManager.GetInstance();
+        
         if (m_fHunger <= m_fHungerDamageThreshold || m_fThirst <= m_fThirstDamageThreshold)
         {
+            effects.AddEffect(GetOwner(), SCR_EZombieStatusEffect.STARVATION);
+            
             // Apply damage for starvation/dehydration
             DamageManagerComponent dmgMgr = DamageManagerComponent.Cast(GetOwner().FindComponent(DamageManagerComponent));
             if (dmgMgr)
@@ -73,30 +82,21 @@ class SCR_ZombieSurvivalComponent : ScriptComponent
                 
                 dmgMgr.InflictDamage(params);
             }
-            
-            // Apply visual effects
-            ApplyStarvationVisualEffects();
         }
-    }
-    
-    protected void ApplyStarvationVisualEffects()
-    {
-        SCR_PostProcessEffectsComponent ppEffects = SCR_PostProcessEffectsComponent.Cast(GetOwner().FindComponent(SCR_PostProcessEffectsComponent));
-        if (ppEffects)
+        else
         {
-            float hungerEffect = 1.0 - (m_fHunger / 100.0);
-            float thirstEffect = 1.0 - (m_fThirst / 100.0);
-            float combinedEffect = Math.Max(hungerEffect, thirstEffect);
-            
-            ppEffects.SetVignetteIntensity(0.3 * combinedEffect);
-            ppEffects.SetDesaturation(0.4 * combinedEffect);
+            effects.RemoveEffect(GetOwner(), SCR_EZombieStatusEffect.STARVATION);
         }
     }
     
-    protected void UpdateSurvivalUI()
+    // Visual effects are composed on the owning client from this quantized state
+    protected void ReplicateState()
     {
-        // Update UI elements
-        // This would connect to your HUD system
+        if (!m_PlayerState)
+            m_PlayerState = SCR_ZombiePlayerStateComponent.Cast(GetOwner().FindComponent(SCR_ZombiePlayerStateComponent));
+            
+        if (m_PlayerState)
+            m_PlayerState.SetSurvival(m_fHunger, m_fThirst);
     }
     
     float GetHunger()
@@ -109,12 +109,21 @@ class SCR_ZombieSurvivalComponent : ScriptComponent
         return m_fThirst;
     }
     
+    void SetSurvivalValues(float hunger, float thirst)
+    {
+        m_fHunger = Math.Clamp(hunger, 0, 100);
+        m_fThirst = Math.Clamp(thirst, 0, 100);
+        ReplicateState();
+    }
+    
     void AddHunger(float amount)
     {
         m_fHunger += amount;
         
         if (m_fHunger > 100)
             m_fHunger = 100;
+            
+        ReplicateState();
     }
     
     void AddThirst(float amount)
@@ -123,5 +132,7 @@ class SCR_ZombieSurvivalComponent : ScriptComponent
         
         if (m_fThirst > 100)
             m_fThirst = 100;
+            
+        ReplicateState();
     }
 }
@@ -9,6 +9,12 @@ class SCR_ZombieSurvivalManager : ScriptComponent
     [Attribute("15.0", UIWidgets.Auto, "Medical item respawn time in minutes")]
     protected float m_fMedicalRespawnTime;
     
+    [Attribute("5.0", UIWidgets.Auto, "Interval in seconds between respawn queue checks")]
+    protected float m_fRespawnCheckInterval;
+    
+    [Attribute("8", UIWidgets.Auto, "Maximum number of spawners respawned per timer tick and category")]
+    protected int m_iRespawnBudgetPerTick;
+    
     [Attribute("$FOOD_SPAWNER_PREFAB", UIWidgets.ResourceNamePicker, "Food spawner prefab")]
     protected ResourceName m_FoodSpawnerPrefab;
     
@@ -18,97 +24,98 @@ class SCR_ZombieSurvivalManager : ScriptComponent
     [Attribute("$MEDICAL_SPAWNER_PREFAB", UIWidgets.ResourceNamePicker, "Medical spawner prefab")]
     protected ResourceName m_MedicalSpawnerPrefab;
     
-    protected ref array<IEntity> m_aFoodSpawners = new array<IEntity>();
-    protected ref array<IEntity> m_aWaterSpawners = new array<IEntity>();
-    protected ref array<IEntity> m_aMedicalSpawners = new array<IEntity>();
+    // Respawn check timer per SCR_EZombieLootCategory, each on its own jittered phase
+    protected ref array<int> m_aRespawnTimers = {0, 0, 0};
+    
+    // Worst respawn slice seen, for the performance log
+    protected int m_iPeakSliceSpawners;
+    protected int m_iSliceCount;
+    
+    // Respawn delay in ms per SCR_EZombieLootCategory
+    protected ref array<float> m_aRespawnDelays = new array<float>();
+    
+    // Reused between checks to avoid per-check allocations
+    protected ref array<SCR_ZombieItemSpawnerComponent> m_aDueSpawners = new array<SCR_ZombieItemSpawnerComponent>();
     
     override void OnPostInit(IEntity owner)
     {
         super.OnPostInit(owner);
         
-        // Find all spawners in the world
-        FindAllSpawners();
+        // Indexed by SCR_EZombieLootCategory
+        m_aRespawnDelays.Insert(m_fFoodRespawnTime * 60 * 1000);
+        m_aRespawnDelays.Insert(m_fWaterRespawnTime * 60 * 1000);
+        m_aRespawnDelays.Insert(m_fMedicalRespawnTime * 60 * 1000);
         
-        // Initialize regular respawn cycles
-        GetGame().GetCallqueue().CallLater(RespawnFoodItems, m_fFoodRespawnTime * 60 * 1000, true);
-        GetGame().GetCallqueue().CallLater(RespawnWaterItems, m_fWaterRespawnTime * 60 * 1000, true);
-        GetGame().GetCallqueue().CallLater(RespawnMedicalItems, m_fMedicalRespawnTime * 60 * 1000, true);
+        // Emptied spawners queue themselves with SCR_ZombieLootSpawnerRegistry, only due ones are visited.
+        // Random phases keep the categories from checking in the same frame.
+        SCR_ZombieTimerWheel timers = SCR_ZombieTimerWheel.GetInstance();
+        float checkInterval = m_fRespawnCheckInterval * 1000;
+        m_aRespawnTimers[SCR_EZombieLootCategory.FOOD] = timers.Schedule(RespawnFoodItems, Math.RandomFloat(0, checkInterval));
+        m_aRespawnTimers[SCR_EZombieLootCategory.WATER] = timers.Schedule(RespawnWaterItems, Math.RandomFloat(0, checkInterval));
+        m_aRespawnTimers[SCR_EZombieLootCategory.MEDICAL] = timers.Schedule(RespawnMedicalItems, Math.RandomFloat(0, checkInterval));
     }
     
     override void OnDelete(IEntity owner)
     {
-        GetGame().GetCallqueue().Remove(RespawnFoodItems);
-        GetGame().GetCallqueue().Remove(RespawnWaterItems);
-        GetGame().GetCallqueue().Remove(RespawnMedicalItems);
+        foreach (int respawnTimer : m_aRespawnTimers)
+        {
+            SCR_ZombieTimerWheel.CancelTimer(respawnTimer);
+        }
+        
         super.OnDelete(owner);
     }
     
-    protected void FindAllSpawners()
+    int GetPeakSliceSpawners()
     {
-        // Find all spawner entities in the world
-        array<IEntity> allEntities = new array<IEntity>();
-        GetGame().GetWorld().GetEntityRegistry().FindEntitiesByName("*_Spawner", allEntities);
-        
-        foreach (IEntity entity : allEntities)
-        {
-            if (entity.GetName().Contains("Food"))
-            {
-                m_aFoodSpawners.Insert(entity);
-            }
-            else if (entity.GetName().Contains("Water"))
-            {
-                m_aWaterSpawners.Insert(entity);
-            }
-            else if (entity.GetName().Contains("Medical"))
-            {
-                m_aMedicalSpawners.Insert(entity);
-            }
-        }
+        return m_iPeakSliceSpawners;
     }
     
-    protected void RespawnFoodItems()
+    int GetSliceCount()
     {
-        foreach (IEntity spawner : m_aFoodSpawners)
-        {
-            if (!spawner)
-                continue;
-                
-            // Check if spawner is empty
-            SCR_ZombieItemSpawnerComponent spawnerComp = SCR_ZombieItemSpawnerComponent.Cast(spawner.FindComponent(SCR_ZombieItemSpawnerComponent));
-            if (spawnerComp && spawnerComp.IsEmpty())
-            {
-                spawnerComp.SpawnItem();
-            }
-        }
+        return m_iSliceCount;
     }
     
-    protected void RespawnWaterItems()
+    protected void RespawnFoodItems(Managed context = null)
     {
-        foreach (IEntity spawner : m_aWaterSpawners)
-        {
-            if (!spawner)
-                continue;
-                
-            SCR_ZombieItemSpawnerComponent spawnerComp = SCR_ZombieItemSpawnerComponent.Cast(spawner.FindComponent(SCR_ZombieItemSpawnerComponent));
-            if (spawnerComp && spawnerComp.IsEmpty())
-            {
-                spawnerComp.SpawnItem();
-            }
-        }
+        ProcessRespawnSlice(SCR_EZombieLootCategory.FOOD, RespawnFoodItems);
+    }
+    
+    protected void RespawnWaterItems(Managed context = null)
+    {
+        ProcessRespawnSlice(SCR_EZombieLootCategory.WATER, RespawnWaterItems);
+    }
+    
+    protected void RespawnMedicalItems(Managed context = null)
+    {
+        ProcessRespawnSlice(SCR_EZombieLootCategory.MEDICAL, RespawnMedicalItems);
     }
     
-    protected void RespawnMedicalItems()
+    // Respawns at most the per-tick budget of due spawners. A full slice continues on the next
+    // tick, otherwise the next check comes after the interval with some jitter to keep phases apart.
+    protected void ProcessRespawnSlice(SCR_EZombieLootCategory category, SCR_ZombieTimerCallback callback)
     {
-        foreach (IEntity spawner : m_aMedicalSpawners)
+        SCR_ZombieLootSpawnerRegistry registry = SCR_ZombieLootSpawnerRegistry.GetInstance();
+        float now = GetGame().GetWorld().GetWorldTime();
+        
+        m_aDueSpawners.Clear();
+        int popped = registry.PopDue(category, now - m_aRespawnDelays[category], m_aDueSpawners, m_iRespawnBudgetPerTick);
+        
+        foreach (SCR_ZombieItemSpawnerComponent spawnerComp : m_aDueSpawners)
         {
-            if (!spawner)
-                continue;
-                
-            SCR_ZombieItemSpawnerComponent spawnerComp = SCR_ZombieItemSpawnerComponent.Cast(spawner.FindComponent(SCR_ZombieItemSpawnerComponent));
-            if (spawnerComp && spawnerComp.IsEmpty())
-            {
-                spawnerComp.SpawnItem();
-            }
+            spawnerComp.SpawnItem();
+            
+            // Failed spawns, e.g. a missing prefab, go around again instead of being lost
+            if (spawnerComp.IsEmpty())
+                registry.QueueRespawn(spawnerComp);
         }
+        
+        m_iSliceCount++;
+        m_iPeakSliceSpawners = Math.Max(m_iPeakSliceSpawners, popped);
+        
+        float delay = 0;
+        if (popped < m_iRespawnBudgetPerTick)
+            delay = m_fRespawnCheckInterval * 1000 * Math.RandomFloat(0.9, 1.1);
+            
+        m_aRespawnTimers[category] = SCR_ZombieTimerWheel.GetInstance().Schedule(callback, delay);
     }
 }
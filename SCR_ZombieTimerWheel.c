@@ -0,0 +1,395 @@
+void SCR_ZombieTimerCallback(Managed context);
+typedef func SCR_ZombieTimerCallback;
+
+class SCR_ZombieTimerEntry
+{
+    SCR_ZombieTimerCallback m_Callback;
+    
+    // Weak reference, an entity context that gets deleted arrives as null
+    Managed m_Context;
+    
+    int m_iDueTick;
+    int m_iPeriodTicks;
+    int m_iSlot = SCR_ZombieTimerWheel.SLOT_NONE;
+    int m_iNext = -1;
+    int m_iPrev = -1;
+    int m_iGeneration = 1;
+}
+
+// Hierarchical timing wheel shared by every zombie mod subsystem.
+// Four levels of 64 slots at 100 ms resolution cover roughly 19 days; insert and cancel are O(1)
+// through intrusive slot lists, and the whole mod is driven by a single engine call queue entry.
+class SCR_ZombieTimerWheel
+{
+    static const int TICK_MS = 100;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS_PER_LEVEL = 64;
+    static const int SLOT_MASK = 63;
+    static const int LEVEL_COUNT = 4;
+    
+    static const int SLOT_NONE = -1;
+    static const int SLOT_FIRING = -2;
+    
+    // Handles pack the entry index and its generation so stale handles can never cancel a reused entry
+    static const int INDEX_BITS = 20;
+    static const int INDEX_MASK = 0xFFFFF;
+    static const int MAX_GENERATION = 2047;
+    
+    protected static ref SCR_ZombieTimerWheel s_Instance;
+    
+    protected ref array<ref SCR_ZombieTimerEntry> m_aEntries = new array<ref SCR_ZombieTimerEntry>();
+    protected ref array<int> m_aFreeEntries = new array<int>();
+    protected ref array<int> m_aSlotHeads = new array<int>();
+    
+    protected int m_iCurrentTick;
+    protected int m_iQueueLength;
+    protected int m_iFiredLastFrame;
+    protected int m_iPeakFiredPerFrame;
+    protected int m_iCoalescedCount;
+    protected bool m_bRunning;
+    
+    static SCR_ZombieTimerWheel GetInstance()
+    {
+        if (!s_Instance)
+        {
+            s_Instance = new SCR_ZombieTimerWheel();
+            s_Instance.Start();
+        }
+        
+        return s_Instance;
+    }
+    
+    // Null once shut down, for cleanup paths that must not bring a running wheel back
+    static SCR_ZombieTimerWheel FindInstance()
+    {
+        return s_Instance;
+    }
+    
+    // Cancel for OnDelete and shutdown paths, a no-op after the wheel was shut down
+    static void CancelTimer(int handle)
+    {
+        if (s_Instance)
+            s_Instance.Cancel(handle);
+    }
+    
+    static void Shutdown()
+    {
+        if (!s_Instance)
+            return;
+            
+        s_Instance.Stop();
+        s_Instance = null;
+    }
+    
+    void SCR_ZombieTimerWheel()
+    {
+        m_aSlotHeads.Resize(LEVEL_COUNT * SLOTS_PER_LEVEL);
+        for (int i = 0; i < m_aSlotHeads.Count(); i++)
+        {
+            m_aSlotHeads[i] = -1;
+        }
+    }
+    
+    void Start()
+    {
+        if (m_bRunning)
+            return;
+            
+        m_bRunning = true;
+        m_iCurrentTick = GetWorldTick();
+        
+        // The only engine call queue entry the mod keeps, everything else goes through the wheel
+        GetGame().GetCallqueue().CallLater(OnFrame, 0, true);
+    }
+    
+    void Stop()
+    {
+        if (!m_bRunning)
+            return;
+            
+        m_bRunning = false;
+        GetGame().GetCallqueue().Remove(OnFrame);
+    }
+    
+    // Returns a handle that can be passed to Cancel, 0 when nothing was scheduled.
+    // Coalesced requests with the same callback, context and period landing in an occupied bucket
+    // share the already scheduled entry and fire only once.
+    int Schedule(SCR_ZombieTimerCallback callback, float delayMs, bool repeat = false, Managed context = null, bool coalesce = false)
+    {
+        if (!callback)
+            return 0;
+            
+        int delayTicks = Math.Max(1, Math.Ceil(delayMs / TICK_MS));
+        int dueTick = m_iCurrentTick + delayTicks;
+        int periodTicks = 0;
+        if (repeat)
+            periodTicks = delayTicks;
+            
+        if (coalesce)
+        {
+            int existing = FindInSlot(GetSlotIndex(dueTick), callback, context, periodTicks);
+            if (existing != -1)
+            {
+                m_iCoalescedCount++;
+                return MakeHandle(existing, m_aEntries[existing].m_iGeneration);
+            }
+        }
+        
+        int index = AllocateEntry();
+        SCR_ZombieTimerEntry entry = m_aEntries[index];
+        entry.m_Callback = callback;
+        entry.m_Context = context;
+        entry.m_iDueTick = dueTick;
+        entry.m_iPeriodTicks = periodTicks;
+        
+        Link(index);
+        m_iQueueLength++;
+        
+        return MakeHandle(index, entry.m_iGeneration);
+    }
+    
+    bool Cancel(int handle)
+    {
+        int index = ResolveHandle(handle);
+        if (index == -1)
+            return false;
+            
+        SCR_ZombieTimerEntry entry = m_aEntries[index];
+        if (entry.m_iSlot >= 0)
+            Unlink(index);
+            
+        Release(index);
+        return true;
+    }
+    
+    bool IsScheduled(int handle)
+    {
+        return ResolveHandle(handle) != -1;
+    }
+    
+    float GetRemainingMs(int handle)
+    {
+        int index = ResolveHandle(handle);
+        if (index == -1)
+            return 0;
+            
+        return Math.Max(0, m_aEntries[index].m_iDueTick - m_iCurrentTick) * TICK_MS;
+    }
+    
+    int GetQueueLength()
+    {
+        return m_iQueueLength;
+    }
+    
+    int GetFiredLastFrame()
+    {
+        return m_iFiredLastFrame;
+    }
+    
+    int GetPeakFiredPerFrame()
+    {
+        return m_iPeakFiredPerFrame;
+    }
+    
+    int GetCoalescedCount()
+    {
+        return m_iCoalescedCount;
+    }
+    
+    protected void OnFrame()
+    {
+        int targetTick = GetWorldTick();
+        int fired = 0;
+        
+        while (m_iCurrentTick < targetTick)
+        {
+            m_iCurrentTick++;
+            
+            if ((m_iCurrentTick & SLOT_MASK) == 0)
+                Cascade(1);
+                
+            fired += FireSlot(m_iCurrentTick & SLOT_MASK);
+        }
+        
+        m_iFiredLastFrame = fired;
+        if (fired > m_iPeakFiredPerFrame)
+            m_iPeakFiredPerFrame = fired;
+    }
+    
+    protected int FireSlot(int slotIndex)
+    {
+        int fired = 0;
+        int index = m_aSlotHeads[slotIndex];
+        
+        while (index != -1)
+        {
+            SCR_ZombieTimerEntry entry = m_aEntries[index];
+            Unlink(index);
+            entry.m_iSlot = SLOT_FIRING;
+            
+            int generation = entry.m_iGeneration;
+            entry.m_Callback(entry.m_Context);
+            fired++;
+            
+            // Callback may have cancelled its own entry
+            if (entry.m_iGeneration == generation)
+            {
+                if (entry.m_iPeriodTicks > 0)
+                {
+                    entry.m_iDueTick = m_iCurrentTick + entry.m_iPeriodTicks;
+                    Link(index);
+                }
+                else
+                {
+                    Release(index);
+                }
+            }
+            
+            index = m_aSlotHeads[slotIndex];
+        }
+        
+        return fired;
+    }
+    
+    // Moves the entries of the current slot on the given level down to the finer levels
+    protected void Cascade(int level)
+    {
+        int slot = (m_iCurrentTick >> (level * SLOT_BITS)) & SLOT_MASK;
+        if (slot == 0 && level < LEVEL_COUNT - 1)
+            Cascade(level + 1);
+            
+        int slotIndex = level * SLOTS_PER_LEVEL + slot;
+        int index = m_aSlotHeads[slotIndex];
+        m_aSlotHeads[slotIndex] = -1;
+        
+        while (index != -1)
+        {
+            SCR_ZombieTimerEntry entry = m_aEntries[index];
+            int next = entry.m_iNext;
+            
+            entry.m_iNext = -1;
+            entry.m_iPrev = -1;
+            entry.m_iSlot = SLOT_NONE;
+            Link(index);
+            
+            index = next;
+        }
+    }
+    
+    protected int GetSlotIndex(int dueTick)
+    {
+        int delta = Math.Max(0, dueTick - m_iCurrentTick);
+        int level = 0;
+        int span = SLOTS_PER_LEVEL;
+        
+        while (level < LEVEL_COUNT - 1 && delta >= span)
+        {
+            level++;
+            span = span << SLOT_BITS;
+        }
+        
+        // Beyond the coarsest level, park in its farthest slot and re-evaluate on cascade
+        if (delta >= span)
+            dueTick = m_iCurrentTick + span - 1;
+            
+        return level * SLOTS_PER_LEVEL + ((dueTick >> (level * SLOT_BITS)) & SLOT_MASK);
+    }
+    
+    protected int FindInSlot(int slotIndex, SCR_ZombieTimerCallback callback, Managed context, int periodTicks)
+    {
+        int index = m_aSlotHeads[slotIndex];
+        while (index != -1)
+        {
+            SCR_ZombieTimerEntry entry = m_aEntries[index];
+            if (entry.m_Callback == callback && entry.m_Context == context && entry.m_iPeriodTicks == periodTicks)
+                return index;
+                
+            index = entry.m_iNext;
+        }
+        
+        return -1;
+    }
+    
+    protected void Link(int index)
+    {
+        SCR_ZombieTimerEntry entry = m_aEntries[index];
+        int slotIndex = GetSlotIndex(entry.m_iDueTick);
+        int head = m_aSlotHeads[slotIndex];
+        
+        entry.m_iSlot = slotIndex;
+        entry.m_iPrev = -1;
+        entry.m_iNext = head;
+        
+        if (head != -1)
+            m_aEntries[head].m_iPrev = index;
+            
+        m_aSlotHeads[slotIndex] = index;
+    }
+    
+    protected void Unlink(int index)
+    {
+        SCR_ZombieTimerEntry entry = m_aEntries[index];
+        
+        if (entry.m_iPrev != -1)
+            m_aEntries[entry.m_iPrev].m_iNext = entry.m_iNext;
+        else
+            m_aSlotHeads[entry.m_iSlot] = entry.m_iNext;
+            
+        if (entry.m_iNext != -1)
+            m_aEntries[entry.m_iNext].m_iPrev = entry.m_iPrev;
+            
+        entry.m_iNext = -1;
+        entry.m_iPrev = -1;
+        entry.m_iSlot = SLOT_NONE;
+    }
+    
+    protected int AllocateEntry()
+    {
+        if (!m_aFreeEntries.IsEmpty())
+        {
+            int index = m_aFreeEntries[m_aFreeEntries.Count() - 1];
+            m_aFreeEntries.Remove(m_aFreeEntries.Count() - 1);
+            return index;
+        }
+        
+        return m_aEntries.Insert(new SCR_ZombieTimerEntry());
+    }
+    
+    protected void Release(int index)
+    {
+        SCR_ZombieTimerEntry entry = m_aEntries[index];
+        entry.m_Callback = null;
+        entry.m_Context = null;
+        entry.m_iSlot = SLOT_NONE;
+        entry.m_iGeneration = (entry.m_iGeneration % MAX_GENERATION) + 1;
+        
+        m_aFreeEntries.Insert(index);
+        m_iQueueLength--;
+    }
+    
+    protected int MakeHandle(int index, int generation)
+    {
+        return (generation << INDEX_BITS) | index;
+    }
+    
+    protected int ResolveHandle(int handle)
+    {
+        if (handle <= 0)
+            return -1;
+            
+        int index = handle & INDEX_MASK;
+        if (index >= m_aEntries.Count())
+            return -1;
+            
+        SCR_ZombieTimerEntry entry = m_aEntries[index];
+        if (entry.m_iGeneration != (handle >> INDEX_BITS) || !entry.m_Callback)
+            return -1;
+            
+        return index;
+    }
+    
+    protected int GetWorldTick()
+    {
+        return GetGame().GetWorld().GetWorldTime() / TICK_MS;
+    }
+}
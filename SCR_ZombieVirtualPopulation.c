@@ -0,0 +1,88 @@
+class SCR_ZombieVirtualRecord
+{
+    vector m_vPosition;
+    int m_iCellKey;
+    int m_iIndex;
+}
+
+// Zombies that exist only as a position. Records are kept dense for iteration and bucketed in a
+// spatial grid, so materializing the ones around players only visits nearby cells.
+class SCR_ZombieVirtualPopulation
+{
+    static const float GRID_CELL_SIZE = 100;
+    
+    protected ref array<ref SCR_ZombieVirtualRecord> m_aRecords = new array<ref SCR_ZombieVirtualRecord>();
+    protected ref SCR_ZombieSpatialGrid m_Grid = new SCR_ZombieSpatialGrid(GRID_CELL_SIZE);
+    protected ref array<Managed> m_aQueryResults = new array<Managed>();
+    
+    int Count()
+    {
+        return m_aRecords.Count();
+    }
+    
+    vector GetPosition(int index)
+    {
+        return m_aRecords[index].m_vPosition;
+    }
+    
+    SCR_ZombieVirtualRecord Add(vector position)
+    {
+        SCR_ZombieVirtualRecord record = new SCR_ZombieVirtualRecord();
+        record.m_vPosition = position;
+        record.m_iIndex = m_aRecords.Insert(record);
+        record.m_iCellKey = m_Grid.Insert(record, position);
+        return record;
+    }
+    
+    void Remove(SCR_ZombieVirtualRecord record)
+    {
+        int index = record.m_iIndex;
+        if (index < 0 || index >= m_aRecords.Count() || m_aRecords[index] != record)
+            return;
+            
+        m_Grid.Remove(record, record.m_iCellKey);
+        
+        int last = m_aRecords.Count() - 1;
+        if (index != last)
+        {
+            m_aRecords[index] = m_aRecords[last];
+            m_aRecords[index].m_iIndex = index;
+        }
+        
+        m_aRecords.Remove(last);
+        record.m_iIndex = -1;
+    }
+    
+    // Appends the records between minDistance and maxDistance of the center on the XZ plane
+    int Query(vector center, float minDistance, float maxDistance, notnull array<SCR_ZombieVirtualRecord> outRecords)
+    {
+        m_aQueryResults.Clear();
+        m_Grid.Query(center, maxDistance, m_aQueryResults);
+        
+        float minDistanceSq = minDistance * minDistance;
+        float maxDistanceSq = maxDistance * maxDistance;
+        int found = 0;
+        
+        foreach (Managed item : m_aQueryResults)
+        {
+            SCR_ZombieVirtualRecord record = SCR_ZombieVirtualRecord.Cast(item);
+            if (!record)
+                continue;
+                
+            float distanceSq = vector.DistanceSqXZ(center, record.m_vPosition);
+            if (distanceSq < minDistanceSq || distanceSq > maxDistanceSq)
+                continue;
+                
+            outRecords.Insert(record);
+            found++;
+        }
+        
+        return found;
+    }
+    
+    void Clear()
+    {
+        m_aRecords.Clear();
+        m_Grid.Clear();
+    }
+}
@@ -24,27 +24,120 @@ class ZombieManager : ScriptComponent
     [Attribute("30", UIWidgets.Auto, "Management update interval in seconds")]
     protected float m_fManagementInterval;
     
+    [Attribute("10", UIWidgets.Auto, "Spawn position attempts per frame while seeding the initial population")]
+    protected int m_iSeedBatchSize;
+    
+    [Attribute("0.5", UIWidgets.Auto, "Attacker slot assignment interval in seconds")]
+    protected float m_fAttackSlotInterval;
+    
+    [Attribute("1000", UIWidgets.Auto, "Radius in meters of the far horde summary sent to clients for cosmetic crowds")]
+    protected float m_fHordeSummaryRadius;
+    
+    [Attribute("5", UIWidgets.Auto, "Far horde summary interval in seconds")]
+    protected float m_fHordeSummaryInterval;
+    
+    [Attribute("", UIWidgets.EditBox, "Density raster of the map, spawning is uniform around players when empty")]
+    protected string m_sDensityRaster;
+    
+    [Attribute("", UIWidgets.ResourceNamePicker, "Zone archetypes and caps referenced by the density raster", "conf")]
+    protected ResourceName m_ZoneConfig;
+    
+    [Attribute("8", UIWidgets.Auto, "Density weighted candidates tried per spawn")]
+    protected int m_iDensityCandidates;
+    
+    [Attribute("", UIWidgets.ResourceNamePicker, "Baked interior spawn slots per building prefab", "conf")]
+    protected ResourceName m_InteriorSlotConfig;
+    
+    [Attribute("0.3", UIWidgets.Slider, "Chance that a spawn near indexed buildings goes inside one", "0 1 0.05")]
+    protected float m_fInteriorSpawnChance;
+    
+    [Attribute("0", UIWidgets.CheckBox, "Bake listed building prefabs without slots by traces and print them, development only")]
+    protected bool m_bBakeInteriorSlots;
+    
+    [Attribute("10", UIWidgets.Auto, "Seconds ahead along a player's velocity that spawns are centered on")]
+    protected float m_fPredictionTime;
+    
+    [Attribute("50", UIWidgets.Auto, "Distance beyond the despawn distance a zombie must reach before it is removed")]
+    protected float m_fDespawnHysteresis;
+    
+    [Attribute("60", UIWidgets.Auto, "Seconds a zombie lives before it can be despawned")]
+    protected float m_fMinZombieLifetime;
+    
     protected ref array<IEntity> m_aSpawnedZombies = new array<IEntity>();
     protected ref map<IEntity, IEntity> m_mZombieTargets = new map<IEntity, IEntity>();
     
+    // Density raster zone each live zombie counts against
+    protected ref map<IEntity, int> m_mZombieZones = new map<IEntity, int>();
+    protected int m_iDensityRejects;
+    protected int m_iZoneCapRejects;
+    
+    // Spawn world time per live zombie and despawn waste counters
+    protected ref map<IEntity, float> m_mSpawnTimes = new map<IEntity, float>();
+    protected ref array<vector> m_aPredictedPositions = new array<vector>();
+    protected int m_iDespawnCount;
+    protected int m_iUnseenDespawnCount;
+    
+    // Zombies away from every player, seeded at start, restored from a snapshot or despawned;
+    // they are materialized first once a player comes near
+    protected ref SCR_ZombieVirtualPopulation m_VirtualPopulation = new SCR_ZombieVirtualPopulation();
+    protected ref array<SCR_ZombieVirtualRecord> m_aVirtualQuery = new array<SCR_ZombieVirtualRecord>();
+    protected int m_iVirtualCapacity;
+    
+    // Splits spawns between players and player clusters by their deficit
+    protected ref SCR_ZombieQuotaAllocator m_QuotaAllocator = new SCR_ZombieQuotaAllocator();
+    
+    protected int m_iSpawnTimer;
+    protected int m_iManagementTimer;
+    protected int m_iAttackSlotTimer;
+    protected int m_iHordeSummaryTimer;
+    
+    // Far horde summary scratch, zombie count per relative cell
+    protected ref map<int, int> m_mSummaryCounts = new map<int, int>();
+    protected ref array<int> m_aSummary = new array<int>();
+    protected ref array<int> m_aSummaryPlayerIds = new array<int>();
+    
+    // Seeding state
+    protected int m_iSeedTimer;
+    protected int m_iSeedTarget;
+    protected int m_iSeedAttempts;
+    protected int m_iSeedBatches;
+    protected int m_iSeedStartTick;
+    protected int m_iSeedDurationMs = -1;
+    protected vector m_vWorldMins;
+    protected vector m_vWorldMaxs;
+    
     override void OnPostInit(IEntity owner)
     {
         super.OnPostInit(owner);
         
-        GetGame().GetCallqueue().CallLater(SpawnZombieUpdate, m_fSpawnInterval * 1000, true);
-        GetGame().GetCallqueue().CallLater(ManagementUpdate, m_fManagementInterval * 1000, true);
+        SCR_ZombieDensityMap densityMap = SCR_ZombieDensityMap.GetInstance();
+        if (densityMap.Load(m_sDensityRaster, m_ZoneConfig))
+            Print(string.Format("[Zombies] Density raster %1: %2x%3 cells", m_sDensityRaster, densityMap.GetWidth(), densityMap.GetHeight()), LogLevel.NORMAL);
+            
+        SCR_ZombieInteriorSlots interiorSlots = SCR_ZombieInteriorSlots.GetInstance();
+        interiorSlots.Load(m_InteriorSlotConfig, m_bBakeInteriorSlots);
+        interiorSlots.StartIndexing();
+        
+        SCR_ZombieTimerWheel timers = SCR_ZombieTimerWheel.GetInstance();
+        m_iSpawnTimer = timers.Schedule(SpawnZombieUpdate, m_fSpawnInterval * 1000, true);
+        m_iManagementTimer = timers.Schedule(ManagementUpdate, m_fManagementInterval * 1000, true);
+        m_iAttackSlotTimer = timers.Schedule(AssignAttackSlots, m_fAttackSlotInterval * 1000, true);
+        m_iHordeSummaryTimer = timers.Schedule(SendHordeSummaries, m_fHordeSummaryInterval * 1000, true);
     }
     
     override void OnDelete(IEntity owner)
     {
-        GetGame().GetCallqueue().Remove(SpawnZombieUpdate);
-        GetGame().GetCallqueue().Remove(ManagementUpdate);
+        SCR_ZombieTimerWheel.CancelTimer(m_iSpawnTimer);
+        SCR_ZombieTimerWheel.CancelTimer(m_iManagementTimer);
+        SCR_ZombieTimerWheel.CancelTimer(m_iSeedTimer);
+        SCR_ZombieTimerWheel.CancelTimer(m_iAttackSlotTimer);
+        SCR_ZombieTimerWheel.CancelTimer(m_iHordeSummaryTimer);
         
         ClearAllZombies();
         super.OnDelete(owner);
     }
     
-    void SpawnZombieUpdate()
+    void SpawnZombieUpdate(Managed context = null)
     {
         array<IEntity> players = new array<IEntity>();
         GetGame().GetPlayerManager().GetPlayers(players);
@@ -52,34 +145,242 @@ class ZombieManager : ScriptComponent
         if (players.Count() == 0)
             return;
             
-        int totalMaxZombies = players.Count() * m_iMaxZombiesPerPlayer;
+        // Players whose spawn rings overlap share one scaled budget
+        float clusterRadius = m_fSpawnRadius * 2;
+        m_QuotaAllocator.Update(players, m_iMaxZombiesPerPlayer, clusterRadius, m_fSpawnRadius);
+        int totalMaxZombies = Math.Round(m_QuotaAllocator.GetTotalBudget());
         
         if (m_aSpawnedZombies.Count() >= totalMaxZombies)
             return;
             
         int zombiesToSpawn = Math.Min(m_iMaxSpawnAttempts, totalMaxZombies - m_aSpawnedZombies.Count());
+        int materialized = SpawnVirtualZombies(players, zombiesToSpawn);
+        zombiesToSpawn -= materialized;
         
+        // Materialized zombies already count against their cluster
+        if (materialized > 0)
+            m_QuotaAllocator.Update(players, m_iMaxZombiesPerPlayer, clusterRadius, m_fSpawnRadius);
+            
         for (int i = 0; i < zombiesToSpawn; i++)
         {
-            IEntity randomPlayer = players.GetRandomElement();
-            if (!randomPlayer)
-                continue;
+            IEntity spawnPlayer = m_QuotaAllocator.Next();
+            if (!spawnPlayer)
+                break;
                 
-            vector spawnPos = FindZombieSpawnPosition(randomPlayer);
+            vector spawnPos = FindZombieSpawnPosition(spawnPlayer);
             if (!spawnPos[0] && !spawnPos[1] && !spawnPos[2])
                 continue;
                 
-            SpawnZombie(spawnPos, randomPlayer);
+            SpawnZombie(spawnPos, spawnPlayer);
+        }
+    }
+    
+    void RestoreZombie(vector position)
+    {
+        m_VirtualPopulation.Add(position);
+    }
+    
+    array<IEntity> GetZombies()
+    {
+        return m_aSpawnedZombies;
+    }
+    
+    SCR_ZombieQuotaAllocator GetQuotaAllocator()
+    {
+        return m_QuotaAllocator;
+    }
+    
+    SCR_ZombieVirtualPopulation GetVirtualPopulation()
+    {
+        return m_VirtualPopulation;
+    }
+    
+    // Seeds the virtual population across the map in background batches, only positions are
+    // computed, entities follow once players come near
+    void StartSeeding(int count)
+    {
+        m_iSeedTarget = count;
+        m_iVirtualCapacity = Math.Max(m_iVirtualCapacity, count);
+        m_iSeedAttempts = 0;
+        m_iSeedBatches = 0;
+        m_iSeedDurationMs = -1;
+        m_iSeedStartTick = System.GetTickCount();
+        GetGame().GetWorld().GetBoundBox(m_vWorldMins, m_vWorldMaxs);
+        
+        SCR_ZombieTimerWheel timers = SCR_ZombieTimerWheel.GetInstance();
+        timers.Cancel(m_iSeedTimer);
+        m_iSeedTimer = timers.Schedule(SeedBatch, 0);
+    }
+    
+    bool IsSeeding()
+    {
+        return SCR_ZombieTimerWheel.GetInstance().IsScheduled(m_iSeedTimer);
+    }
+    
+    float GetSeedingProgress()
+    {
+        if (m_iSeedTarget <= 0)
+            return 1.0;
+            
+        float seeded = m_VirtualPopulation.Count();
+        return Math.Clamp(seeded / m_iSeedTarget, 0.0, 1.0);
+    }
+    
+    // -1 while seeding has not finished
+    int GetSeedingDurationMs()
+    {
+        return m_iSeedDurationMs;
+    }
+    
+    protected void SeedBatch(Managed context = null)
+    {
+        // Restored snapshot records count towards the target, so seeding waits until the last
+        // record has streamed in and a warm start seeds less
+        SCR_ZombiePersistence persistence = SCR_ZombiePersistence.FindInstance();
+        if (persistence && persistence.IsLoading())
+        {
+            m_iSeedTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(SeedBatch, 0);
+            return;
+        }
+        
+        m_iSeedBatches++;
+        
+        for (int attempt = 0; attempt < m_iSeedBatchSize && m_VirtualPopulation.Count() < m_iSeedTarget; attempt++)
+        {
+            m_iSeedAttempts++;
+            
+            vector candidatePos = Vector(Math.RandomFloat(m_vWorldMins[0], m_vWorldMaxs[0]), 0, Math.RandomFloat(m_vWorldMins[2], m_vWorldMaxs[2]));
+            if (!AcceptDensity(candidatePos))
+                continue;
+                
+            candidatePos[1] = GetGame().GetWorld().GetSurfaceY(candidatePos[0], candidatePos[2]);
+            
+            vector spawnPos = DoTerrainCheck(candidatePos);
+            if (spawnPos[0] || spawnPos[1] || spawnPos[2])
+                m_VirtualPopulation.Add(spawnPos);
+        }
+        
+        // Water heavy maps reject many candidates, give up after a bounded number of attempts
+        bool done = m_VirtualPopulation.Count() >= m_iSeedTarget || m_iSeedAttempts >= m_iSeedTarget * 4;
+        if (!done)
+        {
+            m_iSeedTimer = SCR_ZombieTimerWheel.GetInstance().Schedule(SeedBatch, 0);
+            return;
+        }
+        
+        m_iSeedDurationMs = System.GetTickCount() - m_iSeedStartTick;
+        Print(string.Format("[Zombies] Seeded %1/%2 virtual zombies in %3 ms over %4 batches",
+            m_VirtualPopulation.Count(), m_iSeedTarget, m_iSeedDurationMs, m_iSeedBatches), LogLevel.NORMAL);
+    }
+    
+    // Returns the number of virtual zombies materialized
+    protected int SpawnVirtualZombies(array<IEntity> players, int maxCount)
+    {
+        int spawned = 0;
+        foreach (IEntity player : players)
+        {
+            if (!player || spawned >= maxCount)
+                continue;
+                
+            // Closer ones stay virtual rather than popping into view
+            m_aVirtualQuery.Clear();
+            m_VirtualPopulation.Query(player.GetOrigin(), m_fMinSpawnDistance, m_fSpawnRadius, m_aVirtualQuery);
+            
+            foreach (SCR_ZombieVirtualRecord record : m_aVirtualQuery)
+            {
+                if (spawned >= maxCount)
+                    break;
+                    
+                // Records in a zone at its cap wait until the zone frees up
+                vector position = record.m_vPosition;
+                if (!HasZoneBudget(position))
+                    continue;
+                    
+                m_VirtualPopulation.Remove(record);
+                if (SpawnZombie(position, player))
+                    spawned++;
+            }
+        }
+        
+        return spawned;
+    }
+    
+    // Chasing zombies ask for slots in their AI update, the slots are handed out here
+    void AssignAttackSlots(Managed context = null)
+    {
+        SCR_ZombieAttackSlots.GetInstance().Assign();
+    }
+    
+    // Virtual zombies beyond interaction range are summarized per cell for each client, which
+    // renders them as cosmetic impostors; none of them becomes a server entity for this
+    void SendHordeSummaries(Managed context = null)
+    {
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        m_aSummaryPlayerIds.Clear();
+        playerManager.GetPlayers(m_aSummaryPlayerIds);
+        
+        foreach (int playerId : m_aSummaryPlayerIds)
+        {
+            IEntity playerEntity = playerManager.GetPlayerControlledEntity(playerId);
+            if (!playerEntity)
+                continue;
+                
+            SCR_ZombiePlayerStateComponent playerState = SCR_ZombiePlayerStateComponent.Cast(playerEntity.FindComponent(SCR_ZombiePlayerStateComponent));
+            if (!playerState)
+                continue;
+                
+            vector center = playerEntity.GetOrigin();
+            int originX = SCR_ZombieHordeSummary.GetCellCoord(center[0]);
+            int originZ = SCR_ZombieHordeSummary.GetCellCoord(center[2]);
+            
+            m_aVirtualQuery.Clear();
+            m_VirtualPopulation.Query(center, m_fDespawnDistance, m_fHordeSummaryRadius, m_aVirtualQuery);
+            
+            m_mSummaryCounts.Clear();
+            foreach (SCR_ZombieVirtualRecord record : m_aVirtualQuery)
+            {
+                int offsetX = SCR_ZombieHordeSummary.GetCellCoord(record.m_vPosition[0]) - originX;
+                int offsetZ = SCR_ZombieHordeSummary.GetCellCoord(record.m_vPosition[2]) - originZ;
+                int key = SCR_ZombieHordeSummary.PackCell(offsetX, offsetZ, 0, 0);
+                m_mSummaryCounts.Set(key, m_mSummaryCounts.Get(key) + 1);
+            }
+            
+            m_aSummary.Clear();
+            m_aSummary.Insert(SCR_ZombieHordeSummary.PackOrigin(originX, originZ));
+            foreach (int cellKey, int count : m_mSummaryCounts)
+            {
+                int cellOffsetX = SCR_ZombieHordeSummary.UnpackOffsetX(cellKey);
+                int cellOffsetZ = SCR_ZombieHordeSummary.UnpackOffsetZ(cellKey);
+                int heading = SCR_ZombieHordeSummary.GetCellHeading(originX + cellOffsetX, originZ + cellOffsetZ);
+                m_aSummary.Insert(SCR_ZombieHordeSummary.PackCell(cellOffsetX, cellOffsetZ, count, heading));
+            }
+            
+            playerState.SendHordeSummary(m_aSummary);
         }
     }
     
-    void ManagementUpdate()
+    void ManagementUpdate(Managed context = null)
     {
         array<IEntity> players = new array<IEntity>();
         GetGame().GetPlayerManager().GetPlayers(players);
         
         if (players.Count() == 0 || m_aSpawnedZombies.Count() == 0)
             return;
+            
+        // Zombies ahead of a moving player are kept for when the player gets there
+        m_aPredictedPositions.Clear();
+        foreach (IEntity predictedPlayer : players)
+        {
+            if (predictedPlayer)
+                m_aPredictedPositions.Insert(GetPredictedPosition(predictedPlayer));
+        }
+        
+        float now = GetGame().GetWorld().GetWorldTime();
+        float minLifetimeMs = m_fMinZombieLifetime * 1000;
+        float keepDistance = m_fDespawnDistance + m_fDespawnHysteresis;
+        float keepDistanceSq = keepDistance * keepDistance;
+        SCR_ZombieNetRelevancy relevancy = SCR_ZombieNetRelevancy.GetInstance();
+        bool lostZombies = false;
         
         for (int i = m_aSpawnedZombies.Count() - 1; i >= 0; i--)
         {
@@ -87,40 +388,172 @@ class ZombieManager : ScriptComponent
             if (!zombie)
             {
                 m_aSpawnedZombies.Remove(i);
+                lostZombies = true;
                 continue;
             }
             
+            float spawnTime;
+            if (m_mSpawnTimes.Find(zombie, spawnTime) && now - spawnTime < minLifetimeMs)
+                continue;
+                
             bool shouldDespawn = true;
             vector zombiePos = zombie.GetOrigin();
             
             foreach (IEntity player : players)
             {
-                float distance = vector.Distance(zombiePos, player.GetOrigin());
-                if (distance < m_fDespawnDistance)
+                if (player && vector.DistanceSq(zombiePos, player.GetOrigin()) < keepDistanceSq)
                 {
                     shouldDespawn = false;
                     break;
                 }
             }
             
+            foreach (vector predictedPos : m_aPredictedPositions)
+            {
+                if (!shouldDespawn)
+                    break;
+                    
+                if (vector.DistanceSq(zombiePos, predictedPos) < keepDistanceSq)
+                    shouldDespawn = false;
+            }
+            
             if (shouldDespawn)
             {
+                // Keep it in the world as a position while the pool has room
+                if (m_VirtualPopulation.Count() < m_iVirtualCapacity)
+                    m_VirtualPopulation.Add(zombiePos);
+                    
+                m_iDespawnCount++;
+                if (!relevancy.WasSeen(zombie))
+                    m_iUnseenDespawnCount++;
+                    
                 DeleteZombie(zombie);
                 m_aSpawnedZombies.Remove(i);
             }
         }
+        
+        // One rebuild per sweep however many were deleted behind the manager's back
+        if (lostZombies)
+        {
+            m_mSpawnTimes.Remove(null);
+            RecountZones();
+        }
     }
     
+    // The spawn ring is centered on where the player will be, so zombies spawned behind a fast
+    // player or a vehicle are not despawned right away. Interior slots are tried first when
+    // buildings are near. With a density raster the ring candidates are rejection sampled by cell
+    // density and zone budget, both O(1) lookups, before the terrain traces run on the survivor
     vector FindZombieSpawnPosition(IEntity nearPlayer)
     {
         vector playerPos = nearPlayer.GetOrigin();
-        float angle = Math.RandomFloat(0, Math.PI2);
-        float distance = Math.RandomFloat(m_fMinSpawnDistance, m_fSpawnRadius);
+        vector center = GetPredictedPosition(nearPlayer);
+        float minDistanceSq = m_fMinSpawnDistance * m_fMinSpawnDistance;
         
-        vector offset = Vector(Math.Cos(angle) * distance, 0, Math.Sin(angle) * distance);
-        vector candidatePos = playerPos + offset;
+        // Baked interior slots are valid as they are, no traces needed
+        vector interiorPos;
+        if (Math.RandomFloat01() < m_fInteriorSpawnChance)
+        {
+            bool found = SCR_ZombieInteriorSlots.GetInstance().FindSlot(center, m_fMinSpawnDistance, m_fSpawnRadius, interiorPos);
+            if (found && vector.DistanceSqXZ(interiorPos, playerPos) >= minDistanceSq && HasZoneBudget(interiorPos))
+                return interiorPos;
+        }
+            
+        int candidates = 1;
+        if (SCR_ZombieDensityMap.GetInstance().IsLoaded())
+            candidates = m_iDensityCandidates;
+            
+        for (int i = 0; i < candidates; i++)
+        {
+            float angle = Math.RandomFloat(0, Math.PI2);
+            float distance = Math.RandomFloat(m_fMinSpawnDistance, m_fSpawnRadius);
+            
+            vector offset = Vector(Math.Cos(angle) * distance, 0, Math.Sin(angle) * distance);
+            vector candidatePos = center + offset;
+            if (vector.DistanceSqXZ(candidatePos, playerPos) < minDistanceSq)
+                continue;
+                
+            if (!AcceptDensity(candidatePos))
+            {
+                m_iDensityRejects++;
+                continue;
+            }
+            
+            if (!HasZoneBudget(candidatePos))
+            {
+                m_iZoneCapRejects++;
+                continue;
+            }
+            
+            return DoTerrainCheck(candidatePos);
+        }
         
-        return DoTerrainCheck(candidatePos);
+        return vector.Zero;
+    }
+    
+    // Position along the velocity of whatever the player rides in, capped at the spawn radius
+    vector GetPredictedPosition(IEntity player)
+    {
+        vector position = player.GetOrigin();
+        Physics physics = player.GetRootParent().GetPhysics();
+        if (!physics)
+            return position;
+            
+        vector lead = physics.GetVelocity() * m_fPredictionTime;
+        lead[1] = 0;
+        float leadLength = lead.Length();
+        if (leadLength > m_fSpawnRadius)
+            lead = lead * (m_fSpawnRadius / leadLength);
+            
+        return position + lead;
+    }
+    
+    int GetDespawnCount()
+    {
+        return m_iDespawnCount;
+    }
+    
+    // Share of despawned zombies no player ever had in view, spawn work that bought nothing
+    float GetDespawnWasteRatio()
+    {
+        if (m_iDespawnCount == 0)
+            return 0;
+            
+        float unseen = m_iUnseenDespawnCount;
+        return unseen / m_iDespawnCount;
+    }
+    
+    // Keeps a candidate with probability proportional to its cell density, always without a raster
+    protected bool AcceptDensity(vector position)
+    {
+        SCR_ZombieDensityMap densityMap = SCR_ZombieDensityMap.GetInstance();
+        if (!densityMap.IsLoaded())
+            return true;
+            
+        int density = SCR_ZombieDensityMap.GetDensity(densityMap.Sample(position));
+        if (density > 0 && Math.RandomInt(0, SCR_ZombieDensityMap.MAX_DENSITY) < density)
+            return true;
+            
+        return false;
+    }
+    
+    protected bool HasZoneBudget(vector position)
+    {
+        SCR_ZombieDensityMap densityMap = SCR_ZombieDensityMap.GetInstance();
+        if (!densityMap.IsLoaded())
+            return true;
+            
+        return densityMap.HasZoneBudget(SCR_ZombieDensityMap.GetZone(densityMap.Sample(position)));
+    }
+    
+    int GetDensityRejectCount()
+    {
+        return m_iDensityRejects;
+    }
+    
+    int GetZoneCapRejectCount()
+    {
+        return m_iZoneCapRejects;
     }
     
     vector DoTerrainCheck(vector position)
@@ -182,7 +615,19 @@ class ZombieManager : ScriptComponent
     
     IEntity SpawnZombie(vector position, IEntity nearPlayer)
     {
-        Resource zombieRes = Resource.Load(m_ZombiePrefab);
+        // The zone picks the zombie type, zones without archetypes use the default prefab
+        SCR_ZombieDensityMap densityMap = SCR_ZombieDensityMap.GetInstance();
+        ResourceName prefab = m_ZombiePrefab;
+        int zone = -1;
+        if (densityMap.IsLoaded())
+        {
+            zone = SCR_ZombieDensityMap.GetZone(densityMap.Sample(position));
+            ResourceName archetype = densityMap.DrawArchetype(zone);
+            if (!archetype.IsEmpty())
+                prefab = archetype;
+        }
+        
+        Resource zombieRes = Resource.Load(prefab);
         if (!zombieRes)
             return null;
             
@@ -200,6 +645,16 @@ class ZombieManager : ScriptComponent
         // Add to tracking arrays
         m_aSpawnedZombies.Insert(zombieEntity);
         m_mZombieTargets.Insert(zombieEntity, nearPlayer);
+        m_mSpawnTimes.Insert(zombieEntity, GetGame().GetWorld().GetWorldTime());
+        if (zone != -1)
+        {
+            m_mZombieZones.Insert(zombieEntity, zone);
+            densityMap.AddZoneCount(zone, 1);
+        }
+        
+        SCR_ZombieMovementLOD.GetInstance().Register(zombieEntity, nearPlayer);
+        SCR_ZombieNetRelevancy.GetInstance().Register(zombieEntity);
+        SCR_ZombieHordeManager.GetInstance().Register(zombieEntity);
         
         return zombieEntity;
     }
@@ -218,6 +673,11 @@ class ZombieManager : ScriptComponent
         if (controller)
         {
             ConfigureZombieMovement(controller);
+            
+            // Dead zombies leave the registry right away instead of at the next management sweep
+            SCR_CharacterControllerComponent scrController = SCR_CharacterControllerComponent.Cast(controller);
+            if (scrController)
+                scrController.GetOnPlayerDeathWithParam().Insert(OnZombieDeath);
         }
         
         // Configure animations
@@ -306,36 +766,8 @@ class ZombieManager : ScriptComponent
         audio.SetSoundEvent("SOUND_ZOMBIE_ATTACK", "ZombieAttack");
         audio.SetSoundEvent("SOUND_ZOMBIE_DEATH", "ZombieDeath");
         
-        // Start ambient zombie sounds
-        GetGame().GetCallqueue().CallLater(PlayRandomZombieSound, Math.RandomFloat(5000, 15000), false, audio);
-    }
-    
-    void PlayRandomZombieSound(AudioComponent audio)
-    {
-        if (!audio || !audio.GetOwner())
-            return;
-        
-        // Select a random zombie sound
-        int soundType = Math.RandomInt(0, 3);
-        string soundEvent;
-        
-        switch (soundType)
-        {
-            case 0:
-                soundEvent = "SOUND_ZOMBIE_IDLE";
-                break;
-            case 1:
-                soundEvent = "SOUND_ZOMBIE_ALERT";
-                break;
-            case 2:
-                soundEvent = "SOUND_ZOMBIE_IDLE";
-                break;
-        }
-        
-        audio.PlaySound(soundEvent);
-        
-        // Schedule next sound
-        GetGame().GetCallqueue().CallLater(PlayRandomZombieSound, Math.RandomFloat(8000, 20000), false, audio);
+        // Ambient sounds are scheduled and budgeted by the audio director
+        SCR_ZombieAudioDirector.GetInstance().Register(audio);
     }
     
     void ConfigureZombieDamageHandling(DamageManagerComponent damageManager)
@@ -352,15 +784,81 @@ class ZombieManager : ScriptComponent
         damageManager.SetBodyPartDamageMultiplier("Head", 2.0);
     }
     
+    protected void OnZombieDeath(SCR_CharacterControllerComponent controller, IEntity killerEntity, Instigator killer)
+    {
+        IEntity zombie = controller.GetOwner();
+        m_aSpawnedZombies.RemoveItem(zombie);
+        m_mZombieTargets.Remove(zombie);
+        m_mSpawnTimes.Remove(zombie);
+        ReleaseZone(zombie);
+        UnregisterZombie(zombie);
+        
+        // The corpse stays until the cleanup service removes it out of sight
+        SCR_ZombieCleanupManager cleanup = SCR_ZombieCleanupManager.GetInstance();
+        if (cleanup)
+            cleanup.Track(zombie, SCR_EZombieCleanupType.CORPSE);
+    }
+    
     void DeleteZombie(IEntity zombie)
     {
         if (!zombie)
             return;
             
         m_mZombieTargets.Remove(zombie);
+        m_mSpawnTimes.Remove(zombie);
+        ReleaseZone(zombie);
+        UnregisterZombie(zombie);
         SCR_EntityHelper.DeleteEntityAndChildren(zombie);
     }
     
+    // Subsystems already shut down at game mode end are not brought back
+    protected void UnregisterZombie(IEntity zombie)
+    {
+        SCR_ZombieAudioDirector audioDirector = SCR_ZombieAudioDirector.FindInstance();
+        if (audioDirector)
+            audioDirector.Unregister(zombie);
+            
+        SCR_ZombieMovementLOD movementLOD = SCR_ZombieMovementLOD.FindInstance();
+        if (movementLOD)
+            movementLOD.Unregister(zombie);
+            
+        SCR_ZombieNetRelevancy relevancy = SCR_ZombieNetRelevancy.FindInstance();
+        if (relevancy)
+            relevancy.Unregister(zombie);
+            
+        SCR_ZombieHordeManager hordes = SCR_ZombieHordeManager.FindInstance();
+        if (hordes)
+            hordes.Unregister(zombie);
+            
+        SCR_ZombieAttackSlots attackSlots = SCR_ZombieAttackSlots.FindInstance();
+        if (attackSlots)
+            attackSlots.Forget(zombie);
+    }
+    
+    // Zombies deleted behind the manager's back leave stale entries, the counts are rebuilt from the live ones
+    protected void RecountZones()
+    {
+        SCR_ZombieDensityMap densityMap = SCR_ZombieDensityMap.GetInstance();
+        densityMap.ResetZoneCounts();
+        m_mZombieZones.Remove(null);
+        foreach (IEntity zombie, int zone : m_mZombieZones)
+        {
+            densityMap.AddZoneCount(zone, 1);
+        }
+    }
+    
+    protected void ReleaseZone(IEntity zombie)
+    {
+        int zone;
+        if (!m_mZombieZones.Find(zombie, zone))
+            return;
+            
+        m_mZombieZones.Remove(zombie);
+        SCR_ZombieDensityMap densityMap = SCR_ZombieDensityMap.FindInstance();
+        if (densityMap)
+            densityMap.AddZoneCount(zone, -1);
+    }
+    
     void ClearAllZombies()
     {
         foreach (IEntity zombie : m_aSpawnedZombies)
@@ -371,5 +869,31 @@ class ZombieManager : ScriptComponent
         
         m_aSpawnedZombies.Clear();
         m_mZombieTargets.Clear();
+        m_mZombieZones.Clear();
+        m_mSpawnTimes.Clear();
+        
+        SCR_ZombieDensityMap densityMap = SCR_ZombieDensityMap.FindInstance();
+        if (densityMap)
+            densityMap.ResetZoneCounts();
+            
+        SCR_ZombieAudioDirector audioDirector = SCR_ZombieAudioDirector.FindInstance();
+        if (audioDirector)
+            audioDirector.Clear();
+            
+        SCR_ZombieMovementLOD movementLOD = SCR_ZombieMovementLOD.FindInstance();
+        if (movementLOD)
+            movementLOD.Clear();
+            
+        SCR_ZombieNetRelevancy relevancy = SCR_ZombieNetRelevancy.FindInstance();
+        if (relevancy)
+            relevancy.Clear();
+            
+        SCR_ZombieHordeManager hordes = SCR_ZombieHordeManager.FindInstance();
+        if (hordes)
+            hordes.Clear();
+            
+        SCR_ZombieAttackSlots attackSlots = SCR_ZombieAttackSlots.FindInstance();
+        if (attackSlots)
+            attackSlots.Clear();
     }
 }